@@ -0,0 +1,119 @@
+/*
+    Copyright (c) 2016 Martin Buck
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#ifndef FLAGGEDT_BENCH_H
+#define FLAGGEDT_BENCH_H
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+//------------------------------------------------------------------------------
+
+///keeps the compiler from optimizing away the computation of value
+template <typename T>
+inline void do_not_optimize(T const& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile T sink;
+    sink = value;
+#endif
+}
+
+///runs f repeats times and returns the mean duration in nanoseconds
+template <typename F>
+double measure(std::size_t repeats, F&& f) {
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < repeats; ++i)
+        f();
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / repeats;
+}
+
+inline void report(char const* name, double ns) {
+    std::printf("%-40s %12.3f ns\n", name, ns);
+}
+
+//------------------------------------------------------------------------------
+
+struct Options {
+    std::string format = "csv"; ///csv or json
+    std::size_t maxSize = 1000000; ///largest container size for the size dependent benchmarks
+    std::size_t threads = 4;
+};
+
+///--format=csv|json --max-size=N --threads=N
+inline Options parse_options(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        char const* arg = argv[i];
+        if (std::strncmp(arg, "--format=", 9) == 0)
+            options.format = arg + 9;
+        else if (std::strncmp(arg, "--max-size=", 11) == 0)
+            options.maxSize = static_cast<std::size_t>(std::strtod(arg + 11, nullptr));
+        else if (std::strncmp(arg, "--threads=", 10) == 0)
+            options.threads = std::strtoul(arg + 10, nullptr, 10);
+    }
+    return options;
+}
+
+///one measurement of a flagged type (variant "flagged") or its raw baseline (variant "raw")
+struct Result {
+    std::string benchmark;
+    std::string variant;
+    std::size_t n;
+    double nsPerOp;
+};
+
+class Results {
+    std::vector<Result> rows;
+
+public:
+    void add(std::string benchmark, std::string variant, std::size_t n, double nsPerOp) {
+        rows.push_back(Result{ std::move(benchmark), std::move(variant), n, nsPerOp });
+    }
+
+    void write(Options const& options, std::FILE* out = stdout) const {
+        if (options.format == "json")
+            write_json(out);
+        else
+            write_csv(out);
+    }
+
+    void write_csv(std::FILE* out) const {
+        std::fprintf(out, "benchmark,variant,n,ns_per_op\n");
+        for (auto const& r : rows)
+            std::fprintf(out, "\"%s\",%s,%zu,%.4f\n", r.benchmark.c_str(), r.variant.c_str(), r.n, r.nsPerOp);
+    }
+
+    void write_json(std::FILE* out) const {
+        std::fprintf(out, "[\n");
+        for (std::size_t i = 0; i < rows.size(); ++i) {
+            auto const& r = rows[i];
+            std::fprintf(out, "  {\"benchmark\": \"%s\", \"variant\": \"%s\", \"n\": %zu, \"ns_per_op\": %.4f}%s\n",
+                r.benchmark.c_str(), r.variant.c_str(), r.n, r.nsPerOp, i + 1 < rows.size() ? "," : "");
+        }
+        std::fprintf(out, "]\n");
+    }
+};
+
+}
+
+#endif // FLAGGEDT_BENCH_H
@@ -0,0 +1,82 @@
+/*
+    Copyright (c) 2016 Martin Buck
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+#include "flaggedT.h"
+
+using namespace std;
+using namespace flaggedT;
+
+//construction of checked types at different failure rates
+//the allocating baseline throws a std::logic_error built from a std::string, as FlaggedTError used to
+
+static vector<int> input(size_t n, double failureRate) {
+    vector<int> result(n);
+    const size_t every = failureRate > 0.0 ? static_cast<size_t>(1.0 / failureRate) : 0;
+    for (size_t i = 0; i < n; ++i)
+        result[i] = (every && i % every == 0) ? -1 : static_cast<int>(i % 1000) + 1;
+    return result;
+}
+
+static int positive_allocating(int x) {
+    if (x <= 0)
+        throw logic_error(string("Can't pass <= 0 to constructor of Positive"));
+    return x;
+}
+
+int main() {
+    const size_t n = 100000;
+
+    for (double rate : { 0.0, 0.001, 0.01, 0.1, 0.5 }) {
+        const auto in = input(n, rate);
+
+        const double tFlagged = bench::measure(5, [&] {
+            int64_t sum = 0;
+            for (int x : in) {
+                try {
+                    sum += Positive<int>(move(x)).get();
+                } catch (FlaggedTError const& e) {
+                    sum -= static_cast<int64_t>(e.value());
+                }
+            }
+            bench::do_not_optimize(sum);
+        });
+
+        const double tAllocating = bench::measure(5, [&] {
+            int64_t sum = 0;
+            for (int x : in) {
+                try {
+                    sum += positive_allocating(x);
+                } catch (logic_error const&) {
+                    sum -= 1;
+                }
+            }
+            bench::do_not_optimize(sum);
+        });
+
+        char name[64];
+        snprintf(name, sizeof(name), "Positive<int> %.1f%% invalid", rate * 100.0);
+        bench::report(name, tFlagged / n);
+        snprintf(name, sizeof(name), "allocating error %.1f%% invalid", rate * 100.0);
+        bench::report(name, tAllocating / n);
+    }
+
+    return 0;
+}
@@ -0,0 +1,747 @@
+/*
+    Copyright (c) 2016 Martin Buck
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench.h"
+#include "flaggedT.h"
+
+using namespace std;
+using namespace flaggedT;
+using namespace bench;
+
+//every flagged measurement is paired with its raw T baseline doing the same work
+//usage: bench_flaggedT [--format=csv|json] [--max-size=N] [--threads=N]
+
+//------------------------------------------------------------------------------
+
+static const size_t N_MICRO = 100000;
+static const size_t REPEATS_MICRO = 50;
+
+template <typename T>
+static vector<T> numbers(size_t n, T first, T step) {
+    vector<T> result(n);
+    for (size_t i = 0; i < n; ++i)
+        result[i] = first + static_cast<T>(i % 64) * step;
+    return result;
+}
+
+static vector<int> random_ints(size_t n, int maxValue) {
+    mt19937 gen(42);
+    uniform_int_distribution<int> dist(0, maxValue);
+    vector<int> result(n);
+    for (auto& x : result)
+        x = dist(gen);
+    return result;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename Flag, typename T>
+static void numeric(Results& results, string const& name, vector<T> const& in) {
+    const size_t n = in.size();
+
+    results.add(name + "/construct", "flagged", n, measure(REPEATS_MICRO, [&] {
+        T sum = 0;
+        for (auto x : in)
+            sum += Flag(move(x)).get();
+        do_not_optimize(sum);
+    }) / n);
+
+    results.add(name + "/construct", "raw", n, measure(REPEATS_MICRO, [&] {
+        T sum = 0;
+        for (auto x : in)
+            sum += x;
+        do_not_optimize(sum);
+    }) / n);
+
+    vector<Flag> flags;
+    flags.reserve(n);
+    for (auto x : in)
+        flags.push_back(Flag(move(x)));
+
+    results.add(name + "/get", "flagged", n, measure(REPEATS_MICRO, [&] {
+        T sum = 0;
+        for (auto const& f : flags)
+            sum += f.get();
+        do_not_optimize(sum);
+    }) / n);
+
+    results.add(name + "/get", "raw", n, measure(REPEATS_MICRO, [&] {
+        T sum = 0;
+        for (auto const& x : in)
+            sum += x;
+        do_not_optimize(sum);
+    }) / n);
+
+    results.add(name + "/unwrap", "flagged", n, measure(REPEATS_MICRO, [&] {
+        T sum = 0;
+        for (auto f : flags)
+            sum += move(f).unwrap();
+        do_not_optimize(sum);
+    }) / n);
+
+    results.add(name + "/unwrap", "raw", n, measure(REPEATS_MICRO, [&] {
+        T sum = 0;
+        for (auto x : in)
+            sum += move(x);
+        do_not_optimize(sum);
+    }) / n);
+}
+
+template <typename From, typename To, typename T>
+static void conversion(Results& results, string const& name, vector<T> const& in) {
+    const size_t n = in.size();
+
+    vector<From> from;
+    from.reserve(n);
+    for (auto x : in)
+        from.push_back(From(move(x)));
+
+    results.add(name + "/convert", "flagged", n, measure(REPEATS_MICRO, [&] {
+        T sum = 0;
+        for (auto const& f : from)
+            sum += To(f).get();
+        do_not_optimize(sum);
+    }) / n);
+
+    results.add(name + "/convert", "raw", n, measure(REPEATS_MICRO, [&] {
+        T sum = 0;
+        for (auto x : in)
+            sum += x;
+        do_not_optimize(sum);
+    }) / n);
+}
+
+template <typename Flag>
+static void container(Results& results, string const& name) {
+    using C = array<int, 4>;
+    const size_t n = N_MICRO;
+    const C c = { 1, 2, 3, 4 };
+
+    results.add(name + "/construct", "flagged", n, measure(REPEATS_MICRO, [&] {
+        int sum = 0;
+        for (size_t i = 0; i < n; ++i)
+            sum += Flag(C(c)).get()[i % 4];
+        do_not_optimize(sum);
+    }) / n);
+
+    results.add(name + "/construct", "raw", n, measure(REPEATS_MICRO, [&] {
+        int sum = 0;
+        for (size_t i = 0; i < n; ++i)
+            sum += C(c)[i % 4];
+        do_not_optimize(sum);
+    }) / n);
+}
+
+template <typename Flag>
+static void ordering(Results& results, string const& name, Options const& options, void (*raw)(vector<int>&)) {
+    for (size_t n = 100; n <= options.maxSize; n *= 10) {
+        const auto in = random_ints(n, static_cast<int>(n / 10));
+        const size_t repeats = max<size_t>(1, 10000000 / (n * 10));
+
+        results.add(name + "/construct", "flagged", n, measure(repeats, [&] {
+            auto f = Flag(vector<int>(in));
+            do_not_optimize(f.get().data());
+        }) / n);
+
+        results.add(name + "/construct", "raw", n, measure(repeats, [&] {
+            auto v = vector<int>(in);
+            raw(v);
+            do_not_optimize(v.data());
+        }) / n);
+    }
+}
+
+static void raw_sort(vector<int>& v) {
+    sort(v.begin(), v.end());
+}
+
+static void raw_sort_unique(vector<int>& v) {
+    sort(v.begin(), v.end());
+    v.erase(unique(v.begin(), v.end()), v.end());
+}
+
+static void raw_unique(vector<int>& v) {
+    v.erase(unique(v.begin(), v.end()), v.end());
+}
+
+//expensive computed key, Sorted caches it per element while the raw baseline computes it per comparison
+struct digit_sum {
+    int operator()(string const& s) const {
+        int sum = 0;
+        for (char c : s)
+            sum += c - '0';
+        return sum;
+    }
+};
+
+static vector<uint64_t> random_uint64s(size_t n, uint64_t seed) {
+    mt19937_64 gen(seed);
+    vector<uint64_t> result(n);
+    for (auto& x : result)
+        x = gen();
+    return result;
+}
+
+//lookups of random keys, ns per lookup
+static void search(Results& results, Options const& options) {
+    const size_t nQueries = 1 << 16;
+    const auto queries = random_uint64s(nQueries, 7);
+
+    for (size_t n = 1000; n <= options.maxSize; n *= 10) {
+        const auto index = SortedIndex<vector<uint64_t>>(random_uint64s(n, 42));
+        vector<uint64_t> const& raw = index.get();
+        const size_t repeats = 10;
+
+        results.add("SortedIndex<vector<uint64_t>>/lower_bound", "flagged", n, measure(repeats, [&] {
+            size_t sum = 0;
+            for (auto q : queries)
+                sum += index.rank(q);
+            do_not_optimize(sum);
+        }) / nQueries);
+
+        results.add("SortedIndex<vector<uint64_t>>/lower_bound", "raw", n, measure(repeats, [&] {
+            size_t sum = 0;
+            for (auto q : queries)
+                sum += static_cast<size_t>(lower_bound(raw.begin(), raw.end(), q) - raw.begin());
+            do_not_optimize(sum);
+        }) / nQueries);
+
+        Sorted<vector<uint64_t>> const& sorted = index;
+        results.add("Sorted<vector<uint64_t>>/lower_bound", "flagged", n, measure(repeats, [&] {
+            size_t sum = 0;
+            for (auto q : queries)
+                sum += sorted.rank(q);
+            do_not_optimize(sum);
+        }) / nQueries);
+
+        results.add("Sorted<vector<uint64_t>>/lower_bound", "raw", n, measure(repeats, [&] {
+            size_t sum = 0;
+            for (auto q : queries)
+                sum += static_cast<size_t>(lower_bound(raw.begin(), raw.end(), q) - raw.begin());
+            do_not_optimize(sum);
+        }) / nQueries);
+
+        vector<size_t> ranks(nQueries);
+        results.add("Sorted<vector<uint64_t>>/lower_bound batch", "flagged", n, measure(repeats, [&] {
+            sorted.ranks(queries.begin(), queries.end(), ranks.begin());
+            do_not_optimize(ranks.data());
+        }) / nQueries);
+
+        results.add("Sorted<vector<uint64_t>>/lower_bound batch", "raw", n, measure(repeats, [&] {
+            for (size_t i = 0; i < nQueries; ++i)
+                ranks[i] = static_cast<size_t>(lower_bound(raw.begin(), raw.end(), queries[i]) - raw.begin());
+            do_not_optimize(ranks.data());
+        }) / nQueries);
+
+        const auto learned = LearnedIndex<vector<uint64_t>>(Sorted<vector<uint64_t>>(sorted));
+        results.add("LearnedIndex<vector<uint64_t>>/lower_bound", "flagged", n, measure(repeats, [&] {
+            size_t sum = 0;
+            for (auto q : queries)
+                sum += learned.rank(q);
+            do_not_optimize(sum);
+        }) / nQueries);
+
+        results.add("LearnedIndex<vector<uint64_t>>/lower_bound", "raw", n, measure(repeats, [&] {
+            size_t sum = 0;
+            for (auto q : queries)
+                sum += static_cast<size_t>(lower_bound(raw.begin(), raw.end(), q) - raw.begin());
+            do_not_optimize(sum);
+        }) / nQueries);
+    }
+}
+
+//posting lists of 1 in 8 ids, lookups and intersections with a 64 times smaller list on the encoded data vs the uncompressed vectors
+static void compressed_sets(Results& results, Options const& options) {
+    const size_t nQueries = 1 << 16;
+
+    for (size_t n = 1000; n <= options.maxSize; n *= 10) {
+        vector<uint32_t> ids[2];
+        for (size_t list : { 0, 1 })
+            for (auto x : random_uint64s(list == 0 ? n : n / 64, 42 + list))
+                ids[list].push_back(static_cast<uint32_t>(x % (8 * n)));
+        auto a = UniqueAndSorted<vector<uint32_t>>(move(ids[0]));
+        auto b = UniqueAndSorted<vector<uint32_t>>(move(ids[1]));
+        vector<uint32_t> const& rawA = a.get();
+        vector<uint32_t> const& rawB = b.get();
+        const auto compressedA = CompressedSortedSet<uint32_t>(a);
+        const auto compressedB = CompressedSortedSet<uint32_t>(b);
+
+        vector<uint32_t> queries;
+        for (auto x : random_uint64s(nQueries, 7))
+            queries.push_back(static_cast<uint32_t>(x % (8 * n)));
+        const size_t repeats = 10;
+
+        results.add("CompressedSortedSet<uint32_t>/contains", "flagged", n, measure(repeats, [&] {
+            size_t found = 0;
+            for (auto q : queries)
+                found += compressedA.contains(q);
+            do_not_optimize(found);
+        }) / nQueries);
+
+        results.add("CompressedSortedSet<uint32_t>/contains", "raw", n, measure(repeats, [&] {
+            size_t found = 0;
+            for (auto q : queries)
+                found += binary_search(rawA.begin(), rawA.end(), q);
+            do_not_optimize(found);
+        }) / nQueries);
+
+        results.add("CompressedSortedSet<uint32_t>/intersection", "flagged", n, measure(repeats, [&] {
+            auto both = intersection(compressedA, compressedB);
+            do_not_optimize(both.get().data());
+        }) / n);
+
+        results.add("CompressedSortedSet<uint32_t>/intersection", "raw", n, measure(repeats, [&] {
+            vector<uint32_t> both;
+            set_intersection(rawA.begin(), rawA.end(), rawB.begin(), rawB.end(), back_inserter(both));
+            do_not_optimize(both.data());
+        }) / n);
+    }
+}
+
+//dense sets of 1 in 4 ids, set algebra on the bitmaps vs the merges of the uncompressed vectors, ns per element
+static void roaring_sets(Results& results, Options const& options) {
+    for (size_t n = 100000; n <= options.maxSize; n *= 10) {
+        vector<uint32_t> ids[2];
+        for (size_t list : { 0, 1 })
+            for (auto x : random_uint64s(n, 42 + list))
+                ids[list].push_back(static_cast<uint32_t>(x % (4 * n)));
+        auto a = UniqueAndSorted<vector<uint32_t>>(move(ids[0]));
+        auto b = UniqueAndSorted<vector<uint32_t>>(move(ids[1]));
+        vector<uint32_t> const& rawA = a.get();
+        vector<uint32_t> const& rawB = b.get();
+        const auto roaringA = RoaringBitmap(a);
+        const auto roaringB = RoaringBitmap(b);
+        const size_t repeats = 10;
+
+        results.add("RoaringBitmap/intersection", "flagged", n, measure(repeats, [&] {
+            auto both = roaringA & roaringB;
+            do_not_optimize(both.size());
+        }) / n);
+
+        results.add("RoaringBitmap/intersection", "raw", n, measure(repeats, [&] {
+            vector<uint32_t> both;
+            set_intersection(rawA.begin(), rawA.end(), rawB.begin(), rawB.end(), back_inserter(both));
+            do_not_optimize(both.data());
+        }) / n);
+
+        results.add("RoaringBitmap/union", "flagged", n, measure(repeats, [&] {
+            auto either = roaringA | roaringB;
+            do_not_optimize(either.size());
+        }) / n);
+
+        results.add("RoaringBitmap/union", "raw", n, measure(repeats, [&] {
+            vector<uint32_t> either;
+            set_union(rawA.begin(), rawA.end(), rawB.begin(), rawB.end(), back_inserter(either));
+            do_not_optimize(either.data());
+        }) / n);
+    }
+}
+
+//values within [0, 1000], deduplicated into a bitset vs sorting and deduplicating a vector, ns per value
+static void bounded_set(Results& results, Options const& options) {
+    using Value = BoundedInclusive<int, 0, 999>;
+
+    for (size_t n = 1000; n <= options.maxSize; n *= 10) {
+        vector<Value> in;
+        for (auto x : random_ints(n, 999))
+            in.push_back(Value(move(x)));
+        const size_t repeats = max<size_t>(1, 10000000 / (n * 10));
+
+        results.add("BoundedSet<int, 0, 999>/construct", "flagged", n, measure(repeats, [&] {
+            auto set = BoundedSet<int, 0, 999>(Unique<vector<Value>>(vector<Value>(in)));
+            do_not_optimize(set.size());
+        }) / n);
+
+        results.add("BoundedSet<int, 0, 999>/construct", "raw", n, measure(repeats, [&] {
+            auto set = UniqueAndSorted<vector<Value>>(vector<Value>(in));
+            do_not_optimize(set.get().size());
+        }) / n);
+
+        auto set = BoundedSet<int, 0, 999>();
+        for (auto const& x : in)
+            set.insert(x);
+        const auto sorted = set.decompress();
+
+        results.add("BoundedSet<int, 0, 999>/contains", "flagged", n, measure(repeats, [&] {
+            size_t found = 0;
+            for (auto const& x : in)
+                found += set.contains(x);
+            do_not_optimize(found);
+        }) / n);
+
+        results.add("BoundedSet<int, 0, 999>/contains", "raw", n, measure(repeats, [&] {
+            size_t found = 0;
+            for (auto const& x : in)
+                found += sorted.contains(x);
+            do_not_optimize(found);
+        }) / n);
+    }
+}
+
+//lookups of keys of which 99% are missing, the raw baseline searches each of them
+static void bloom_filtered(Results& results, Options const& options) {
+    for (size_t n = 1000; n <= options.maxSize; n *= 10) {
+        const auto all = random_ints(2 * n, 100 * static_cast<int>(min<size_t>(n, 20000000)));
+        const vector<int> in(all.begin(), all.begin() + static_cast<ptrdiff_t>(n));
+        const vector<int> keys(all.begin() + static_cast<ptrdiff_t>(n), all.end());
+        const size_t repeats = max<size_t>(1, 1000000 / (n * 10));
+
+        const auto set = BloomFiltered<vector<int>>(vector<int>(in));
+        const auto sorted = UniqueAndSorted<vector<int>>(vector<int>(in));
+
+        results.add("BloomFiltered<vector<int>>/contains", "flagged", n, measure(repeats, [&] {
+            size_t found = 0;
+            for (auto x : keys)
+                found += set.contains(x);
+            do_not_optimize(found);
+        }) / n);
+
+        results.add("BloomFiltered<vector<int>>/contains", "raw", n, measure(repeats, [&] {
+            size_t found = 0;
+            for (auto x : keys)
+                found += binary_search(sorted.get().begin(), sorted.get().end(), x);
+            do_not_optimize(found);
+        }) / n);
+    }
+}
+
+//sorting to a file within an eighth of the memory of the data (8 runs), the raw baseline sorts in memory and writes the result
+static void stream_builder(Results& results, Options const& options) {
+    for (size_t n = 1000; n <= options.maxSize; n *= 10) {
+        const auto in = random_ints(n, 1000000000);
+        const size_t repeats = max<size_t>(1, 1000000 / (n * 10));
+
+        results.add("SortedStreamBuilder<int>/finish", "flagged", n, measure(repeats, [&] {
+            auto builder = SortedStreamBuilder<int>(".", n / 8 * sizeof(int));
+            builder.push(in.begin(), in.end());
+            const auto file = builder.finish("flaggedT_bench_sorted");
+            do_not_optimize(file.size());
+        }) / n);
+
+        results.add("SortedStreamBuilder<int>/finish", "raw", n, measure(repeats, [&] {
+            auto v = vector<int>(in);
+            sort(v.begin(), v.end());
+            FILE* file = fopen("flaggedT_bench_sorted", "wb");
+            fwrite(v.data(), sizeof(int), v.size(), file);
+            fclose(file);
+            do_not_optimize(v.data());
+        }) / n);
+    }
+    remove("flaggedT_bench_sorted");
+}
+
+//opening a saved file for searches, the raw baseline reads it into memory and sorts it again
+static void sorted_view(Results& results, Options const& options) {
+    for (size_t n = 1000; n <= options.maxSize; n *= 10) {
+        const auto in = random_ints(n, 1000000000);
+        const size_t repeats = max<size_t>(1, 1000000 / (n * 10));
+        save(Sorted<vector<int>>(vector<int>(in)), "flaggedT_bench_view");
+
+        const auto raw = [&] {
+            auto v = vector<int>(n);
+            FILE* file = fopen("flaggedT_bench_view", "rb");
+            fseek(file, 64, SEEK_SET);
+            do_not_optimize(fread(v.data(), sizeof(int), n, file));
+            fclose(file);
+            sort(v.begin(), v.end());
+            do_not_optimize(v.data());
+        };
+
+        for (auto verification : { Verification::Trusted, Verification::Order }) {
+            const string name = string("SortedView<int>/open (") + (verification == Verification::Trusted ? "trusted" : "order verified") + ")";
+
+            results.add(name, "flagged", n, measure(repeats, [&] {
+                const auto view = SortedView<int>("flaggedT_bench_view", verification);
+                do_not_optimize(view.contains(in[0]));
+            }) / n);
+
+            results.add(name, "raw", n, measure(repeats, raw) / n);
+        }
+    }
+    remove("flaggedT_bench_view");
+}
+
+//loading saved Sorted data, the raw baseline reads the elements and sorts them again
+static void load_sorted(Results& results, Options const& options) {
+    for (size_t n = 1000; n <= options.maxSize; n *= 10) {
+        const auto in = random_ints(n, 1000000000);
+        const size_t repeats = max<size_t>(1, 1000000 / (n * 10));
+        save(Sorted<vector<int>>(vector<int>(in)), "flaggedT_bench_load");
+
+        const auto raw = [&] {
+            auto v = vector<int>(n);
+            FILE* file = fopen("flaggedT_bench_load", "rb");
+            fseek(file, 64, SEEK_SET);
+            do_not_optimize(fread(v.data(), sizeof(int), n, file));
+            fclose(file);
+            sort(v.begin(), v.end());
+            do_not_optimize(v.data());
+        };
+
+        for (auto verification : { Verification::Trusted, Verification::Checksum, Verification::Order }) {
+            const string name = string("load<Sorted<vector<int>>> (") + (verification == Verification::Trusted ? "trusted" : verification == Verification::Checksum ? "checksum" : "order verified") + ")";
+
+            results.add(name, "flagged", n, measure(repeats, [&] {
+                const auto loaded = load<Sorted<vector<int>>>("flaggedT_bench_load", verification);
+                do_not_optimize(loaded.get().data());
+            }) / n);
+
+            results.add(name, "raw", n, measure(repeats, raw) / n);
+        }
+    }
+    remove("flaggedT_bench_load");
+}
+
+//elements with a small compile time range, Sorted counts them while the raw baseline compares them
+template <typename E>
+static void counting_ordering(Results& results, string const& name, Options const& options, vector<E> const& all) {
+    for (size_t n = 1000; n <= options.maxSize && n <= all.size(); n *= 10) {
+        const vector<E> in(all.begin(), all.begin() + static_cast<ptrdiff_t>(n));
+        const size_t repeats = max<size_t>(1, 10000000 / (n * 10));
+
+        results.add(name + "/construct", "flagged", n, measure(repeats, [&] {
+            auto f = Sorted<vector<E>>(vector<E>(in));
+            do_not_optimize(f.get().data());
+        }) / n);
+
+        results.add(name + "/construct", "raw", n, measure(repeats, [&] {
+            auto v = vector<E>(in);
+            sort(v.begin(), v.end());
+            do_not_optimize(v.data());
+        }) / n);
+    }
+}
+
+//UniqueAndSorted drops duplicate integers by hashing before sorting, distinct is the share of distinct values
+static void dedup_ordering(Results& results, string const& name, Options const& options, double distinct) {
+    for (size_t n = 1000; n <= options.maxSize; n *= 10) {
+        const auto in = random_ints(n, max(1, static_cast<int>(min(static_cast<double>(n) * distinct, 2e9))));
+        const size_t repeats = max<size_t>(1, 10000000 / (n * 10));
+
+        results.add(name + "/construct", "flagged", n, measure(repeats, [&] {
+            auto f = UniqueAndSorted<vector<int>>(vector<int>(in));
+            do_not_optimize(f.get().data());
+        }) / n);
+
+        results.add(name + "/construct", "raw", n, measure(repeats, [&] {
+            auto v = vector<int>(in);
+            raw_sort_unique(v);
+            do_not_optimize(v.data());
+        }) / n);
+    }
+}
+
+static void projected_ordering(Results& results, Options const& options) {
+    for (size_t n = 100; n <= options.maxSize; n *= 10) {
+        const auto ints = random_ints(n, 1000000000);
+        vector<string> in;
+        in.reserve(n);
+        for (auto x : ints)
+            in.push_back(to_string(x) + to_string(x));
+        const size_t repeats = max<size_t>(1, 1000000 / (n * 10));
+
+        results.add("Sorted<vector<string>, less<>, digit_sum>/construct", "flagged", n, measure(repeats, [&] {
+            auto f = Sorted<vector<string>, less<>, digit_sum>(vector<string>(in));
+            do_not_optimize(f.get().data());
+        }) / n);
+
+        results.add("Sorted<vector<string>, less<>, digit_sum>/construct", "raw", n, measure(repeats, [&] {
+            auto v = vector<string>(in);
+            sort(v.begin(), v.end(), [](string const& a, string const& b) { return digit_sum{}(a) < digit_sum{}(b); });
+            do_not_optimize(v.data());
+        }) / n);
+    }
+}
+
+#ifndef FLAGGEDT_NO17
+static void equal_sized(Results& results) {
+    for (size_t n : { size_t(4), size_t(1000) }) {
+        const vector<int> a(n, 1);
+        const vector<double> b(n, 2.0);
+        const size_t repeats = max<size_t>(10, 1000000 / n);
+
+        results.add("EqualSized<vector<int>, vector<double>>/construct", "flagged", n, measure(repeats, [&] {
+            auto es = EqualSized<vector<int>, vector<double>>(vector<int>(a), vector<double>(b));
+            do_not_optimize(get<0>(es.get()).data());
+        }));
+
+        results.add("EqualSized<vector<int>, vector<double>>/construct", "raw", n, measure(repeats, [&] {
+            auto t = make_tuple(vector<int>(a), vector<double>(b));
+            if (get<0>(t).size() != get<1>(t).size())
+                abort();
+            do_not_optimize(get<0>(t).data());
+        }));
+    }
+}
+#endif
+
+template <typename Shared>
+static double copy_under_threads(Shared const& shared, size_t nThreads, size_t copiesPerThread) {
+    return measure(1, [&] {
+        vector<thread> threads;
+        for (size_t t = 0; t < nThreads; ++t)
+            threads.emplace_back([&] {
+                for (size_t i = 0; i < copiesPerThread; ++i) {
+                    Shared copy = shared;
+                    do_not_optimize(copy);
+                }
+            });
+        for (auto& t : threads)
+            t.join();
+    }) / (nThreads * copiesPerThread);
+}
+
+static void shared_immutable(Results& results, Options const& options) {
+    const size_t copies = 200000;
+    for (size_t nThreads = 1; nThreads <= options.threads; nThreads *= 2) {
+        const auto im = shared_im<vector<int>>(vector<int>(100, 1));
+        const auto raw = make_shared<const vector<int>>(vector<int>(100, 1));
+
+        results.add("shared_im<vector<int>>/copy", "flagged", nThreads, copy_under_threads(im, nThreads, copies));
+        results.add("shared_im<vector<int>>/copy", "raw", nThreads, copy_under_threads(raw, nThreads, copies));
+    }
+}
+
+static bool raw_positive(int x, int& out) {
+    if (x <= 0)
+        return false;
+    out = x;
+    return true;
+}
+
+static void failure_paths(Results& results) {
+    const size_t n = 10000;
+    const vector<int> invalid(n, -1);
+
+    results.add("Positive<int>/failure", "flagged", n, measure(5, [&] {
+        size_t failures = 0;
+        for (auto x : invalid) {
+            try {
+                do_not_optimize(Positive<int>(move(x)));
+            } catch (FlaggedTError const&) {
+                ++failures;
+            }
+        }
+        do_not_optimize(failures);
+    }) / n);
+
+    results.add("BoundedInclusive<int, 0, 9>/failure", "flagged", n, measure(5, [&] {
+        size_t failures = 0;
+        for (auto x : invalid) {
+            try {
+                do_not_optimize(BoundedInclusive<int, 0, 9>(move(x)));
+            } catch (FlaggedTError const&) {
+                ++failures;
+            }
+        }
+        do_not_optimize(failures);
+    }) / n);
+
+    results.add("Positive<int>/failure", "raw", n, measure(5, [&] {
+        size_t failures = 0;
+        for (auto x : invalid) {
+            int out;
+            if (!raw_positive(x, out))
+                ++failures;
+        }
+        do_not_optimize(failures);
+    }) / n);
+}
+
+//------------------------------------------------------------------------------
+
+int main(int argc, char** argv) {
+    const auto options = parse_options(argc, argv);
+    Results results;
+
+    const auto ints = numbers<int>(N_MICRO, 1, 1);
+    const auto negInts = numbers<int>(N_MICRO, -1, -1);
+    const auto doubles = numbers<double>(N_MICRO, 0.5, 0.25);
+    const auto powers = vector<int>(N_MICRO, 64);
+
+    numeric<NonZero<int>>(results, "NonZero<int>", ints);
+    numeric<Positive<int>>(results, "Positive<int>", ints);
+    numeric<Positive<double>>(results, "Positive<double>", doubles);
+    numeric<PowerOfTwo<int>>(results, "PowerOfTwo<int>", powers);
+    numeric<NonPositive<int>>(results, "NonPositive<int>", negInts);
+    numeric<Negative<int>>(results, "Negative<int>", negInts);
+    numeric<NonNegative<int>>(results, "NonNegative<int>", ints);
+    numeric<CeiledInclusive<int, 100>>(results, "CeiledInclusive<int, 100>", ints);
+    numeric<CeiledExclusive<int, 100>>(results, "CeiledExclusive<int, 100>", ints);
+    numeric<FlooredInclusive<int, 1>>(results, "FlooredInclusive<int, 1>", ints);
+    numeric<FlooredExclusive<int, 0>>(results, "FlooredExclusive<int, 0>", ints);
+    numeric<BoundedInclusive<int, 1, 100>>(results, "BoundedInclusive<int, 1, 100>", ints);
+    numeric<BoundedExclusive<int, 0, 100>>(results, "BoundedExclusive<int, 0, 100>", ints);
+    numeric<BoundedInclusive<double, 0, 100>>(results, "BoundedInclusive<double, 0, 100>", doubles);
+    numeric<Immutable<int>>(results, "Immutable<int>", ints);
+
+    conversion<Positive<int>, NonZero<int>>(results, "Positive<int> -> NonZero<int>", ints);
+    conversion<BoundedInclusive<int, 1, 100>, Positive<int>>(results, "BoundedInclusive<int, 1, 100> -> Positive<int>", ints);
+    conversion<FlooredInclusive<int, 1>, NonNegative<int>>(results, "FlooredInclusive<int, 1> -> NonNegative<int>", ints);
+    conversion<BoundedInclusive<int, 1, 100>, CeiledInclusive<int, 200>>(results, "BoundedInclusive<int, 1, 100> -> CeiledInclusive<int, 200>", ints);
+
+    container<NonEmpty<array<int, 4>>>(results, "NonEmpty<array<int, 4>>");
+    container<MoreThan<array<int, 4>, 2>>(results, "MoreThan<array<int, 4>, 2>");
+    container<LessThan<array<int, 4>, 8>>(results, "LessThan<array<int, 4>, 8>");
+    container<FixedSized<array<int, 4>, 4>>(results, "FixedSized<array<int, 4>, 4>");
+    container<FixedRangeInclusive<array<int, 4>, 2, 8>>(results, "FixedRangeInclusive<array<int, 4>, 2, 8>");
+
+    ordering<Sorted<vector<int>>>(results, "Sorted<vector<int>>", options, raw_sort);
+    ordering<Unique<vector<int>>>(results, "Unique<vector<int>>", options, raw_unique);
+    ordering<UniqueAndSorted<vector<int>>>(results, "UniqueAndSorted<vector<int>>", options, raw_sort_unique);
+    {
+        vector<uint8_t> bytes;
+        vector<uint16_t> shorts;
+        vector<BoundedInclusive<int, 0, 999>> levels;
+        for (auto x : random_ints(options.maxSize, 65535)) {
+            bytes.push_back(static_cast<uint8_t>(x));
+            shorts.push_back(static_cast<uint16_t>(x));
+            levels.push_back(BoundedInclusive<int, 0, 999>(x % 1000));
+        }
+        counting_ordering(results, "Sorted<vector<uint8_t>>", options, bytes);
+        counting_ordering(results, "Sorted<vector<uint16_t>>", options, shorts);
+        counting_ordering(results, "Sorted<vector<BoundedInclusive<int, 0, 999>>>", options, levels);
+    }
+    dedup_ordering(results, "UniqueAndSorted<vector<int>> (all distinct)", options, 1000.0);
+    dedup_ordering(results, "UniqueAndSorted<vector<int>> (1 in 100 distinct)", options, 0.01);
+    projected_ordering(results, options);
+    search(results, options);
+    compressed_sets(results, options);
+    roaring_sets(results, options);
+    bounded_set(results, options);
+    bloom_filtered(results, options);
+    stream_builder(results, options);
+    sorted_view(results, options);
+    load_sorted(results, options);
+
+#ifndef FLAGGEDT_NO17
+    equal_sized(results);
+#endif
+    shared_immutable(results, options);
+    failure_paths(results);
+
+    results.write(options);
+
+    return 0;
+}
@@ -0,0 +1,64 @@
+/*
+    Copyright (c) 2016 Martin Buck
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include "bench.h"
+#include "flaggedT.h"
+
+using namespace std;
+using namespace flaggedT;
+
+//hash table slot computation: plain modulo by a runtime size vs. the mask of a PowerOfTwo size
+
+static uint64_t mix(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    return x;
+}
+
+int main(int argc, char** argv) {
+    const size_t exponent = argc > 1 ? strtoul(argv[1], nullptr, 10) : 16;
+    const size_t nKeys = 1 << 20;
+
+    vector<uint64_t> keys(nKeys);
+    for (size_t i = 0; i < nKeys; ++i)
+        keys[i] = mix(i);
+
+    //runtime value, so the compiler can't turn the modulo into a mask itself
+    const size_t rawSize = size_t(1) << exponent;
+    const auto size = PowerOfTwo<size_t>(size_t(rawSize));
+
+    const double tModulo = bench::measure(10, [&] {
+        uint64_t sum = 0;
+        for (auto k : keys)
+            sum += k % rawSize;
+        bench::do_not_optimize(sum);
+    });
+
+    const double tMask = bench::measure(10, [&] {
+        uint64_t sum = 0;
+        for (auto k : keys)
+            sum += size.mod(k);
+        bench::do_not_optimize(sum);
+    });
+
+    bench::report("slot modulo (per key)", tModulo / nKeys);
+    bench::report("slot PowerOfTwo::mod (per key)", tMask / nKeys);
+
+    return 0;
+}
@@ -0,0 +1,449 @@
+/*
+    Copyright (c) 2016 Martin Buck
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//FlaggedTBase, FlaggedTError, the reaction to invalid input and the conversion rules shared by all flagged types
+
+#ifndef FLAGGEDT_BASE_H
+#define FLAGGEDT_BASE_H
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "flaggedT_fwd.h"
+
+FLAGGEDT_EXPORT namespace flaggedT {
+
+//------------------------------------------------------------------------------
+
+enum class FlagKind {
+    NonNull,
+    NonZero,
+    Positive,
+    PowerOfTwo,
+    NonPositive,
+    Negative,
+    NonNegative,
+    CeiledInclusive,
+    CeiledExclusive,
+    FlooredInclusive,
+    FlooredExclusive,
+    BoundedInclusive,
+    BoundedExclusive,
+    NonEmpty,
+    MoreThan,
+    LessThan,
+    FixedSized,
+    FixedRangeInclusive,
+    EqualSized,
+    Sorted,
+    UniqueAndSorted
+};
+
+enum class Violation {
+    Null,
+    Zero,
+    TooSmall,
+    TooBig,
+    NotPowerOfTwo,
+    Overflow,
+    SizeMismatch,
+    NotSorted,
+    Duplicate
+};
+
+///thrown on invalid input, never allocates
+///value() is the offending value (or size for containers), bound() the bound it violated, both NaN if not applicable
+class FlaggedTError : public std::exception {
+    char const* msg;
+    FlagKind k;
+    Violation v;
+    double val;
+    double bnd;
+
+public:
+    FlaggedTError(char const* msg, FlagKind kind, Violation violation,
+                  double value = std::numeric_limits<double>::quiet_NaN(),
+                  double bound = std::numeric_limits<double>::quiet_NaN()) noexcept
+        : msg(msg)
+        , k(kind)
+        , v(violation)
+        , val(value)
+        , bnd(bound) {}
+
+    char const* what() const noexcept override {
+        return msg;
+    }
+
+    FlagKind kind() const noexcept {
+        return k;
+    }
+
+    Violation violation() const noexcept {
+        return v;
+    }
+
+    double value() const noexcept {
+        return val;
+    }
+
+    double bound() const noexcept {
+        return bnd;
+    }
+};
+
+//------------------------------------------------------------------------------
+
+//reaction to invalid input, define one of these before including (the same within all translation units):
+//FLAGGEDT_ABORT_ON_VIOLATION   std::abort()
+//FLAGGEDT_ASSUME_VALID         no checks at all, input is assumed to be valid (only if NDEBUG is defined, otherwise throws)
+//FLAGGEDT_COUNT_VIOLATIONS     count in violation_count() and clamp to the nearest valid value (throws if there's none)
+//neither                       throw FlaggedTError
+
+#if defined(FLAGGEDT_ASSUME_VALID) && defined(NDEBUG)
+    #define FLAGGEDT_ASSUMING_VALID
+#endif
+
+namespace detail {
+
+constexpr bool checks_enabled() {
+#ifdef FLAGGEDT_ASSUMING_VALID
+    return false;
+#else
+    return true;
+#endif
+}
+
+inline std::atomic<uint64_t>& violations() {
+    static std::atomic<uint64_t> counter{0};
+    return counter;
+}
+
+///reaction to input which has no valid value to fall back to
+[[noreturn]] inline void violated(FlaggedTError const& e) {
+#if defined(FLAGGEDT_ASSUMING_VALID)
+    (void)e;
+    #if defined(__GNUC__) || defined(__clang__)
+        __builtin_unreachable();
+    #elif defined(_MSC_VER)
+        __assume(false);
+    #else
+        std::abort();
+    #endif
+#elif defined(FLAGGEDT_ABORT_ON_VIOLATION)
+    (void)e;
+    std::abort();
+#else
+    #ifdef FLAGGEDT_COUNT_VIOLATIONS
+        ++violations();
+    #endif
+    throw e;
+#endif
+}
+
+///reaction to input which can be clamped to the valid value clamp()
+template <typename T, typename Clamp>
+void violated(FlaggedTError const& e, T& data, Clamp clamp) {
+#if defined(FLAGGEDT_COUNT_VIOLATIONS) && !defined(FLAGGEDT_ASSUMING_VALID) && !defined(FLAGGEDT_ABORT_ON_VIOLATION)
+    (void)e;
+    ++violations();
+    data = clamp();
+#else
+    (void)data;
+    (void)clamp;
+    violated(e);
+#endif
+}
+
+///clamp targets, only instantiated if clamping actually happens
+template <typename T>
+struct clamp_to {
+    int64_t bound;
+
+    T operator()() const {
+        return static_cast<T>(bound);
+    }
+};
+
+template <typename T>
+struct clamp_above {
+    int64_t bound;
+
+    T operator()() const {
+        return next(std::is_floating_point<T>{});
+    }
+
+private:
+    T next(std::true_type) const {
+        return std::nextafter(static_cast<T>(bound), std::numeric_limits<T>::infinity());
+    }
+
+    T next(std::false_type) const {
+        return static_cast<T>(bound + 1);
+    }
+};
+
+template <typename T>
+struct clamp_below {
+    int64_t bound;
+
+    T operator()() const {
+        return next(std::is_floating_point<T>{});
+    }
+
+private:
+    T next(std::true_type) const {
+        return std::nextafter(static_cast<T>(bound), -std::numeric_limits<T>::infinity());
+    }
+
+    T next(std::false_type) const {
+        return static_cast<T>(bound - 1);
+    }
+};
+
+///payload of FlaggedTError, NaN for types which aren't numbers
+template <typename T>
+constexpr double as_number(T const& x, std::true_type /*arithmetic*/) {
+    return static_cast<double>(x);
+}
+
+template <typename T>
+constexpr double as_number(T const&, std::false_type /*arithmetic*/) {
+    return std::numeric_limits<double>::quiet_NaN();
+}
+
+template <typename T>
+constexpr double as_number(T const& x) {
+    return as_number(x, std::is_arithmetic<T>{});
+}
+
+///tag for the private constructors which skip validation, only reachable via access
+struct trusted_t {};
+
+///grants library internals the construction of flagged types from data already known to be valid
+struct access {
+    template <typename F, typename T>
+    static constexpr F make_trusted(T&& in) {
+        return F(trusted_t{}, std::forward<T>(in));
+    }
+};
+
+//------------------------------------------------------------------------------
+//interval lattice of the numeric and size flags
+//a flag guarantees its value (or container size) lies within an interval, conversions are allowed into every flag with a wider interval
+
+///interval of the values of type V a flag for T guarantees, unbounded sides are marked by HAS_LO / HAS_HI
+///open bounds of integers and sizes are stored as the closed bound next to them, e.g. Positive<int> as [1, inf)
+template <typename T, typename V, bool HAS_LO, V LO, bool LO_OPEN, bool HAS_HI, V HI, bool HI_OPEN, bool NON_ZERO = false>
+struct interval {
+    static constexpr bool discrete = std::is_integral<T>::value || std::is_same<V, std::size_t>::value;
+    static constexpr bool shift_lo = discrete && LO_OPEN && LO < std::numeric_limits<V>::max();
+    static constexpr bool shift_hi = discrete && HI_OPEN && HI > std::numeric_limits<V>::min();
+
+    static constexpr bool known = true;
+    using wrapped_type = T;
+    using value_type = V;
+    static constexpr bool has_lo = HAS_LO;
+    static constexpr V lo = shift_lo ? LO + 1 : LO;
+    static constexpr bool lo_open = LO_OPEN && !shift_lo;
+    static constexpr bool has_hi = HAS_HI;
+    static constexpr V hi = shift_hi ? HI - 1 : HI;
+    static constexpr bool hi_open = HI_OPEN && !shift_hi;
+    ///excludes 0 although it might lie within [lo, hi]
+    static constexpr bool non_zero = NON_ZERO;
+};
+
+///flags without an interval (e.g. Sorted or NonNull) aren't part of the lattice
+template <typename F>
+struct interval_of {
+    static constexpr bool known = false;
+};
+
+template <typename T>
+struct interval_of<NonZero<T>> : interval<T, int64_t, false, 0, false, false, 0, false, true> {};
+
+template <typename T>
+struct interval_of<Positive<T>> : interval<T, int64_t, true, 0, true, false, 0, false> {};
+
+template <typename T>
+struct interval_of<PowerOfTwo<T>> : interval<T, int64_t, true, 1, false, false, 0, false> {};
+
+template <typename T>
+struct interval_of<NonPositive<T>> : interval<T, int64_t, false, 0, false, true, 0, false> {};
+
+template <typename T>
+struct interval_of<Negative<T>> : interval<T, int64_t, false, 0, false, true, 0, true> {};
+
+template <typename T>
+struct interval_of<NonNegative<T>> : interval<T, int64_t, true, 0, false, false, 0, false> {};
+
+template <typename T, int64_t MAX>
+struct interval_of<CeiledInclusive<T, MAX>> : interval<T, int64_t, false, 0, false, true, MAX, false> {};
+
+template <typename T, int64_t MAX>
+struct interval_of<CeiledExclusive<T, MAX>> : interval<T, int64_t, false, 0, false, true, MAX, true> {};
+
+template <typename T, int64_t MIN>
+struct interval_of<FlooredInclusive<T, MIN>> : interval<T, int64_t, true, MIN, false, false, 0, false> {};
+
+template <typename T, int64_t MIN>
+struct interval_of<FlooredExclusive<T, MIN>> : interval<T, int64_t, true, MIN, true, false, 0, false> {};
+
+template <typename T, int64_t MIN, int64_t MAX>
+struct interval_of<BoundedInclusive<T, MIN, MAX>> : interval<T, int64_t, true, MIN, false, true, MAX, false> {};
+
+template <typename T, int64_t MIN, int64_t MAX>
+struct interval_of<BoundedExclusive<T, MIN, MAX>> : interval<T, int64_t, true, MIN, true, true, MAX, true> {};
+
+template <typename T>
+struct interval_of<NonEmpty<T>> : interval<T, std::size_t, true, 1, false, false, 0, false> {};
+
+template <typename T, std::size_t SIZE>
+struct interval_of<MoreThan<T, SIZE>> : interval<T, std::size_t, true, SIZE, true, false, 0, false> {};
+
+template <typename T, std::size_t SIZE>
+struct interval_of<LessThan<T, SIZE>> : interval<T, std::size_t, true, 0, false, true, SIZE, true> {};
+
+template <typename T, std::size_t SIZE>
+struct interval_of<FixedSized<T, SIZE>> : interval<T, std::size_t, true, SIZE, false, true, SIZE, false> {};
+
+template <typename T, std::size_t MINSIZE, std::size_t MAXSIZE>
+struct interval_of<FixedRangeInclusive<T, MINSIZE, MAXSIZE>> : interval<T, std::size_t, true, MINSIZE, false, true, MAXSIZE, false> {};
+
+///whether the lower bound of A is at least as strict as the one of B
+template <typename A, typename B>
+constexpr bool lo_within() {
+    return !B::has_lo
+        || (A::has_lo && (A::lo > B::lo || (A::lo == B::lo && (A::lo_open || !B::lo_open))));
+}
+
+///whether the upper bound of A is at least as strict as the one of B
+template <typename A, typename B>
+constexpr bool hi_within() {
+    return !B::has_hi
+        || (A::has_hi && (A::hi < B::hi || (A::hi == B::hi && (A::hi_open || !B::hi_open))));
+}
+
+template <typename A>
+constexpr bool excludes_zero() {
+    return A::non_zero
+        || (A::has_lo && (A::lo > 0 || (A::lo == 0 && A::lo_open)))
+        || (A::has_hi && (A::hi < 0 || (A::hi == 0 && A::hi_open)));
+}
+
+template <typename A, typename B>
+constexpr bool is_subinterval(std::true_type /*both known*/) {
+    return std::is_same<typename A::wrapped_type, typename B::wrapped_type>::value
+        && std::is_same<typename A::value_type, typename B::value_type>::value
+        && lo_within<A, B>()
+        && hi_within<A, B>()
+        && (!B::non_zero || excludes_zero<A>());
+}
+
+template <typename A, typename B>
+constexpr bool is_subinterval(std::false_type /*both known*/) {
+    return false;
+}
+
+///whether every value of From is a valid value of To, so From converts to To without any check
+template <typename From, typename To>
+constexpr bool is_narrower() {
+    return !std::is_same<From, To>::value
+        && is_subinterval<interval_of<From>, interval_of<To>>(std::integral_constant<bool, interval_of<From>::known && interval_of<To>::known>{});
+}
+
+template <typename From, typename To>
+using if_narrower = typename std::enable_if<is_narrower<From, To>(), int>::type;
+
+#if defined(__cpp_concepts) && __cpp_concepts >= 201907L
+template <typename From, typename To>
+concept narrower_than = is_narrower<From, To>();
+#endif
+
+}
+
+///template parameter F of the single converting constructor of each flag, only matching flags with a narrower interval than TO
+#if defined(__cpp_concepts) && __cpp_concepts >= 201907L
+    #define FLAGGEDT_NARROWER(F, TO) detail::narrower_than<TO> F
+#else
+    #define FLAGGEDT_NARROWER(F, TO) typename F, detail::if_narrower<F, TO> = 0
+#endif
+
+///number of violations so far, only counted with FLAGGEDT_COUNT_VIOLATIONS
+inline uint64_t violation_count() {
+    return detail::violations().load();
+}
+
+//------------------------------------------------------------------------------
+
+template <typename T>
+class FlaggedTBase {
+protected:
+    FlaggedTBase() = delete;
+
+    FlaggedTBase(FlaggedTBase const&) = default;
+    FlaggedTBase(FlaggedTBase&&) = default;
+    FlaggedTBase& operator=(FlaggedTBase const&) = default;
+    FlaggedTBase& operator=(FlaggedTBase&&) = default;
+
+    T data;
+
+    constexpr FlaggedTBase(T const& in)
+        : data(in) {
+
+        assert_zero_cost();
+    }
+
+    constexpr FlaggedTBase(T&& in)
+        : data(std::forward<T>(in)) {
+
+        assert_zero_cost();
+    }
+
+private:
+    ///wrapping must not change how T is copied, passed or laid out (only checkable where the class is complete)
+    static constexpr void assert_zero_cost() {
+        static_assert(sizeof(FlaggedTBase) == sizeof(T), "FlaggedTBase must not add any storage to T");
+        static_assert(!std::is_trivially_copyable<T>::value || std::is_trivially_copyable<FlaggedTBase>::value, "FlaggedTBase must be trivially copyable if T is");
+        static_assert(!std::is_trivially_destructible<T>::value || std::is_trivially_destructible<FlaggedTBase>::value, "FlaggedTBase must be trivially destructible if T is");
+        static_assert(!std::is_standard_layout<T>::value || std::is_standard_layout<FlaggedTBase>::value, "FlaggedTBase must be standard layout if T is");
+    }
+
+public:
+    using wrapped_type = T;
+
+    constexpr T const& get() const {
+        return data;
+    }
+
+    constexpr T&& unwrap() && {
+        return std::move(data);
+    }
+
+    constexpr operator T const& () const {
+        return data;
+    }
+
+    constexpr operator T&& () && {
+        return std::move(data);
+    }
+};
+
+}
+
+#endif // FLAGGEDT_BASE_H
@@ -0,0 +1,225 @@
+/*
+    Copyright (c) 2016 Martin Buck
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//flags of container sizes and EqualSized
+
+#ifndef FLAGGEDT_CONTAINER_H
+#define FLAGGEDT_CONTAINER_H
+
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <utility>
+
+#include "flaggedT_base.h"
+
+FLAGGEDT_EXPORT namespace flaggedT {
+
+//------------------------------------------------------------------------------
+
+template <typename T>
+class NonEmpty : public FlaggedTBase<T> {
+    using base = FlaggedTBase<T>;
+
+protected:
+    ///for derived flags, which validate a stricter condition themselves
+    constexpr NonEmpty(detail::trusted_t, T&& in)
+        : base(std::forward<T>(in)) {}
+
+public:
+    NonEmpty() = delete;
+
+    NonEmpty(NonEmpty const&) = default;
+    NonEmpty(NonEmpty&&) = default;
+    NonEmpty& operator=(NonEmpty const&) = default;
+    NonEmpty& operator=(NonEmpty&&) = default;
+
+    ///THROWS
+    explicit constexpr NonEmpty(T&& in)
+        : base(std::forward<T>(in)) {
+
+        if (base::data.empty())
+            detail::violated(FlaggedTError("Can't pass empty container to constructor of NonEmpty", FlagKind::NonEmpty, Violation::TooSmall, static_cast<double>(base::data.size()), 1));
+    }
+
+    ///from every flag with a narrower interval (see detail::interval_of), without any check
+    template <FLAGGEDT_NARROWER(F, NonEmpty)>
+    constexpr NonEmpty(F in)
+        : base(std::move(in).unwrap()) {}
+};
+
+//------------------------------------------------------------------------------
+
+template <typename T, std::size_t SIZE>
+class MoreThan : public NonEmpty<T>
+{
+    using base = NonEmpty<T>;
+
+public:
+    MoreThan() = delete;
+
+    MoreThan(MoreThan const&) = default;
+    MoreThan(MoreThan&&) = default;
+    MoreThan& operator=(MoreThan const&) = default;
+    MoreThan& operator=(MoreThan&&) = default;
+
+    ///THROWS
+    explicit constexpr MoreThan(T&& in)
+        : base(detail::trusted_t{}, std::forward<T>(in)) {
+
+        if (base::data.size() <= SIZE)
+            detail::violated(FlaggedTError("Passed too small container to constructor of MoreThan", FlagKind::MoreThan, Violation::TooSmall, static_cast<double>(base::data.size()), SIZE));
+    }
+
+    ///from every flag with a narrower interval (see detail::interval_of), without any check
+    template <FLAGGEDT_NARROWER(F, MoreThan)>
+    constexpr MoreThan(F in)
+        : base(detail::trusted_t{}, std::move(in).unwrap()) {}
+};
+
+//------------------------------------------------------------------------------
+
+template <typename T, std::size_t SIZE>
+class LessThan : public FlaggedTBase<T> {
+    using base = FlaggedTBase<T>;
+
+public:
+    LessThan() = delete;
+
+    LessThan(LessThan const&) = default;
+    LessThan(LessThan&&) = default;
+    LessThan& operator=(LessThan const&) = default;
+    LessThan& operator=(LessThan&&) = default;
+
+    ///THROWS
+    explicit constexpr LessThan(T&& in)
+        : base(std::forward<T>(in)) {
+
+        if (base::data.size() >= SIZE)
+            detail::violated(FlaggedTError("Passed too big container to constructor of LessThan", FlagKind::LessThan, Violation::TooBig, static_cast<double>(base::data.size()), SIZE));
+    }
+
+    ///from every flag with a narrower interval (see detail::interval_of), without any check
+    template <FLAGGEDT_NARROWER(F, LessThan)>
+    constexpr LessThan(F in)
+        : base(std::move(in).unwrap()) {}
+};
+
+//------------------------------------------------------------------------------
+
+template <typename T, std::size_t SIZE>
+class FixedSized : public FlaggedTBase<T> {
+    using base = FlaggedTBase<T>;
+
+public:
+    FixedSized() = delete;
+
+    FixedSized(FixedSized const&) = default;
+    FixedSized(FixedSized&&) = default;
+    FixedSized& operator=(FixedSized const&) = default;
+    FixedSized& operator=(FixedSized&&) = default;
+
+    ///THROWS
+    explicit constexpr FixedSized(T&& in)
+        : base(std::forward<T>(in)) {
+
+        if (base::data.size() != SIZE)
+            detail::violated(FlaggedTError("Passed container with wrong size to constructor of FixedSized", FlagKind::FixedSized,
+                base::data.size() < SIZE ? Violation::TooSmall : Violation::TooBig, static_cast<double>(base::data.size()), SIZE));
+    }
+
+    ///from every flag with a narrower interval (see detail::interval_of), without any check
+    template <FLAGGEDT_NARROWER(F, FixedSized)>
+    constexpr FixedSized(F in)
+        : base(std::move(in).unwrap()) {}
+};
+
+//------------------------------------------------------------------------------
+
+template <typename T, std::size_t MINSIZE, std::size_t MAXSIZE>
+class FixedRangeInclusive : public FlaggedTBase<T> {
+    static_assert(MINSIZE <= MAXSIZE, "MINSIZE not <= MAXSIZE");
+
+    using base = FlaggedTBase<T>;
+public:
+    FixedRangeInclusive() = delete;
+
+    FixedRangeInclusive(FixedRangeInclusive const&) = default;
+    FixedRangeInclusive(FixedRangeInclusive&&) = default;
+    FixedRangeInclusive& operator=(FixedRangeInclusive const&) = default;
+    FixedRangeInclusive& operator=(FixedRangeInclusive&&) = default;
+
+    ///THROWS
+    explicit constexpr FixedRangeInclusive(T&& in)
+        : base(std::forward<T>(in)) {
+
+        const auto n = base::data.size();
+        if (n < MINSIZE)
+            detail::violated(FlaggedTError("Passed too small container to constructor of FixedRangeInclusive", FlagKind::FixedRangeInclusive, Violation::TooSmall, static_cast<double>(n), MINSIZE));
+        if (n > MAXSIZE)
+            detail::violated(FlaggedTError("Passed too big container to constructor of FixedRangeInclusive", FlagKind::FixedRangeInclusive, Violation::TooBig, static_cast<double>(n), MAXSIZE));
+    }
+
+    ///from every flag with a narrower interval (see detail::interval_of), without any check
+    template <FLAGGEDT_NARROWER(F, FixedRangeInclusive)>
+    constexpr FixedRangeInclusive(F in)
+        : base(std::move(in).unwrap()) {}
+};
+
+//------------------------------------------------------------------------------
+
+#ifndef FLAGGEDT_NO17
+
+template <typename... Types>
+class EqualSized : public FlaggedTBase<std::tuple<Types...>> {
+    using base = FlaggedTBase<std::tuple<Types...>>;
+
+public:
+    EqualSized() = delete;
+
+    EqualSized(EqualSized const&) = default;
+    EqualSized(EqualSized&&) = default;
+    EqualSized& operator=(EqualSized const&) = default;
+    EqualSized& operator=(EqualSized&&) = default;
+
+    ///THROWS
+    explicit EqualSized(std::tuple<Types...>&& in)
+        : base(std::move(in)) {
+
+        bool initialized{false};
+        size_t size{0};
+
+        auto ensure = [&] (auto x) {
+            if (initialized && size != std::size(x))
+                detail::violated(FlaggedTError("Tried to create EqualSized with elements of different sizes", FlagKind::EqualSized, Violation::SizeMismatch, static_cast<double>(std::size(x)), static_cast<double>(size)));
+            else if (!initialized) {
+                initialized = true;
+                size = std::size(x);
+            }
+            return 0;
+        };
+
+        std::apply([&](auto ...x) { std::make_tuple(ensure(x)...);}, base::data);
+    }
+
+    ///THROWS
+    explicit EqualSized(Types&&... args) :
+        EqualSized(std::make_tuple(args...))
+    {}
+};
+
+#endif
+
+}
+
+#endif // FLAGGEDT_CONTAINER_H
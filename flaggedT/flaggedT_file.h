@@ -0,0 +1,1077 @@
+/*
+    Copyright (c) 2016 Martin Buck
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+//Data within files: sorting of more data than fits into memory, memory mapped views of sorted files and saving / loading flagged data without establishing its flag again
+
+#ifndef FLAGGEDT_FILE_H
+#define FLAGGEDT_FILE_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "flaggedT_container.h"
+#include "flaggedT_numeric.h"
+#include "flaggedT_ordering.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+    #define FLAGGEDT_HAS_MMAP
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+FLAGGEDT_EXPORT namespace flaggedT {
+
+//------------------------------------------------------------------------------
+
+namespace detail {
+
+struct file_closer {
+    void operator()(std::FILE* file) const {
+        std::fclose(file);
+    }
+};
+
+using file_ptr = std::unique_ptr<std::FILE, file_closer>;
+
+///THROWS std::runtime_error
+inline file_ptr open_file(std::string const& path, char const* mode) {
+    file_ptr result(std::fopen(path.c_str(), mode));
+    if (!result)
+        throw std::runtime_error("flaggedT: couldn't open " + path);
+    return result;
+}
+
+///closes file and reports write errors which were buffered until now, THROWS std::runtime_error
+inline void close_file(file_ptr file, std::string const& path) {
+    if (std::fclose(file.release()) != 0)
+        throw std::runtime_error("flaggedT: couldn't write " + path);
+}
+
+///THROWS std::runtime_error
+template <typename T>
+void write_elements(std::FILE* file, T const* data, std::size_t n, std::string const& path) {
+    if (n > 0 && std::fwrite(data, sizeof(T), n, file) != n)
+        throw std::runtime_error("flaggedT: couldn't write " + path);
+}
+
+///term of the 8 byte word w at position index, checksums are the sum of all terms
+inline std::uint64_t checksum_term(std::uint64_t w, std::uint64_t index) {
+    return mix_bits(w ^ (index * 0x9e3779b97f4a7c15ULL));
+}
+
+///sum of the terms of the words of [data, data + 8 * words), the first at position index
+inline std::uint64_t checksum_words(unsigned char const* data, std::size_t words, std::uint64_t index) {
+    std::uint64_t result = 0;
+    for (std::size_t i = 0; i < words; ++i) {
+        std::uint64_t w;
+        std::memcpy(&w, data + 8 * i, sizeof(w));
+        result += checksum_term(w, index + i);
+    }
+    return result;
+}
+
+///order sensitive checksum of a stream of bytes, fed in any pieces
+///as sum over the positions of its words, parts of the stream can also be summed separately (e.g. in parallel) via checksum_words
+class checksum {
+    std::uint64_t sum = 0;
+    std::uint64_t bytes = 0;
+    unsigned char tail[8] = {}; //the bytes of the incomplete last word
+
+public:
+    ///data may be null if n is 0, e.g. the elements of an empty vector
+    void update(void const* data, std::size_t n) {
+        if (n == 0)
+            return;
+        auto p = static_cast<unsigned char const*>(data);
+
+        const auto used = static_cast<std::size_t>(bytes % 8);
+        if (used > 0) {
+            const std::size_t take = std::min<std::size_t>(8 - used, n);
+            std::memcpy(tail + used, p, take);
+            bytes += take;
+            p += take;
+            n -= take;
+            if (bytes % 8 != 0)
+                return;
+            sum += checksum_words(tail, 1, bytes / 8 - 1);
+        }
+
+        const std::size_t words = n / 8;
+        sum += checksum_words(p, words, bytes / 8);
+        bytes += 8 * words;
+        std::memcpy(tail, p + 8 * words, n % 8);
+        bytes += n % 8;
+    }
+
+    ///the incomplete last word is padded with zeros
+    std::uint64_t value() const {
+        std::uint64_t result = sum;
+        if (bytes % 8 != 0) {
+            unsigned char last[8] = {};
+            std::memcpy(last, tail, static_cast<std::size_t>(bytes % 8));
+            result += checksum_words(last, 1, bytes / 8);
+        }
+        return result ^ mix_bits(bytes);
+    }
+};
+
+///f(begin, end) of consecutive chunks of [0, n), a single one unless FLAGGEDT_PARALLEL splits large ranges over FLAGGEDT_PARALLEL_THREADS threads
+template <typename R, typename F>
+std::vector<R> map_chunks(std::size_t n, F f) {
+#ifdef FLAGGEDT_PARALLEL
+    const auto threads = std::min(static_cast<std::size_t>(FLAGGEDT_PARALLEL_THREADS), n);
+    if (threads > 1 && n >= FLAGGEDT_PARALLEL_MIN_SIZE) {
+        std::vector<R> results(threads);
+        {
+            joined_threads workers;
+            for (std::size_t t = 0; t < threads; ++t)
+                workers.start([&results, &f, n, threads, t] {
+                    results[t] = f(n * t / threads, n * (t + 1) / threads);
+                });
+        }
+        return results;
+    }
+#endif
+    return std::vector<R>(1, f(std::size_t(0), n));
+}
+
+///whether check(begin, end) holds for all chunks of [0, n), see map_chunks
+template <typename Check>
+bool all_chunks(std::size_t n, Check check) {
+    const auto results = map_chunks<char>(n, [&check](std::size_t begin, std::size_t end) {
+        return static_cast<char>(check(begin, end));
+    });
+    return std::all_of(results.begin(), results.end(), [](char ok) { return ok != 0; });
+}
+
+///whether pair(data[i - 1], data[i]) holds for all i within [1, n), without early exit within a chunk
+template <typename E, typename Pair>
+bool all_pairs(E const* data, std::size_t n, Pair pair) {
+    return all_chunks(n, [data, &pair](std::size_t begin, std::size_t end) {
+        bool ok = true;
+        for (std::size_t i = std::max<std::size_t>(begin, 1); i < end; ++i)
+            ok &= static_cast<bool>(pair(data[i - 1], data[i]));
+        return ok;
+    });
+}
+
+///checksum of n bytes at once, equal to feeding them to checksum. The words are summed in chunks, see map_chunks
+inline std::uint64_t checksum_of(void const* data, std::size_t n) {
+    auto p = static_cast<unsigned char const*>(data);
+    const std::size_t words = n / 8;
+
+    std::uint64_t result = 0;
+    for (auto sum : map_chunks<std::uint64_t>(words, [p](std::size_t begin, std::size_t end) {
+             return checksum_words(p + 8 * begin, end - begin, begin);
+         }))
+        result += sum;
+
+    if (n % 8 != 0) {
+        unsigned char last[8] = {};
+        std::memcpy(last, p + 8 * words, n % 8);
+        result += checksum_words(last, 1, words);
+    }
+    return result ^ mix_bits(n);
+}
+
+///flags of the elements of a file, recorded within its header
+enum file_flag : std::uint32_t {
+    file_sorted = 1u << 0,
+    file_unique = 1u << 1,  //no element equivalent to its predecessor
+    file_positive = 1u << 2
+};
+
+///leading 64 bytes of the files of save() and SortedStreamBuilder, the elements follow as their raw bytes (aligned to 64 bytes)
+struct file_header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t flags;
+    std::uint64_t elementSize;
+    std::uint64_t count;
+    std::uint64_t checksum;
+    std::uint64_t reserved[3];
+};
+
+static_assert(sizeof(file_header) == 64, "file_header has to take 64 bytes");
+
+inline file_header make_header(std::uint32_t flags, std::uint64_t elementSize, std::uint64_t count, std::uint64_t checksum) {
+    file_header result = {};
+    std::memcpy(result.magic, "FLAGGEDT", sizeof(result.magic));
+    result.version = 1;
+    result.flags = flags;
+    result.elementSize = elementSize;
+    result.count = count;
+    result.checksum = checksum;
+    return result;
+}
+
+///writes a header (unless header is false) and the elements to a file, the header is completed by finish()
+template <typename T>
+class file_writer {
+    file_ptr file;
+    std::string path;
+    std::uint32_t flags;
+    bool header;
+    checksum sum;
+    std::size_t n = 0;
+
+public:
+    ///THROWS std::runtime_error
+    file_writer(std::string const& path, std::uint32_t flags, bool header = true)
+        : file(open_file(path, "wb"))
+        , path(path)
+        , flags(flags)
+        , header(header) {
+
+        if (header) {
+            const file_header placeholder = {};
+            write_elements(file.get(), &placeholder, 1, path);
+        }
+    }
+
+    ///THROWS std::runtime_error
+    void write(T const* data, std::size_t count) {
+        write_elements(file.get(), data, count, path);
+        if (header)
+            sum.update(data, count * sizeof(T));
+        n += count;
+    }
+
+    ///THROWS std::runtime_error
+    void finish() {
+        if (header) {
+            const file_header complete = make_header(flags, sizeof(T), n, sum.value());
+            if (std::fseek(file.get(), 0, SEEK_SET) != 0)
+                throw std::runtime_error("flaggedT: couldn't write " + path);
+            write_elements(file.get(), &complete, 1, path);
+        }
+        close_file(std::move(file), path);
+    }
+};
+
+///sequential reads of the elements of a file from offset bytes on, chunk elements at a time
+template <typename T>
+class chunked_reader {
+    file_ptr file;
+    std::string path;
+    std::vector<T> buffer;
+    std::size_t pos = 0;
+
+    void fill() {
+        buffer.resize(buffer.capacity());
+        const std::size_t n = std::fread(buffer.data(), sizeof(T), buffer.size(), file.get());
+        if (n < buffer.size() && std::ferror(file.get()))
+            throw std::runtime_error("flaggedT: couldn't read " + path);
+        buffer.resize(n);
+        pos = 0;
+    }
+
+public:
+    chunked_reader(std::string const& path, std::size_t chunk, long offset = 0)
+        : file(open_file(path, "rb"))
+        , path(path) {
+
+        if (std::fseek(file.get(), offset, SEEK_SET) != 0)
+            throw std::runtime_error("flaggedT: couldn't read " + path);
+        buffer.reserve(std::max<std::size_t>(chunk, 1));
+        fill();
+    }
+
+    bool done() const {
+        return pos == buffer.size();
+    }
+
+    ///current element (!done())
+    T const& head() const {
+        return buffer[pos];
+    }
+
+    void advance() {
+        if (++pos == buffer.size())
+            fill();
+    }
+};
+
+}
+
+//------------------------------------------------------------------------------
+
+///file of elements sorted by Compare on the keys of Projection, as written by SortedStreamBuilder
+///the elements are stored as their raw bytes after a detail::file_header, they can be read sequentially without loading the whole file,
+///at once via load() or mapped into memory by SortedView
+template <typename T, typename Compare, typename Projection>
+class SortedFile {
+    static_assert(std::is_trivially_copyable<T>::value, "SortedFile requires trivially copyable elements");
+
+    friend class SortedStreamBuilder<T, Compare, Projection>;
+
+    std::string filePath;
+    std::size_t n = 0;
+
+    SortedFile(std::string path, std::size_t n)
+        : filePath(std::move(path))
+        , n(n) {}
+
+public:
+    ///elements read in chunks of this many
+    static constexpr std::size_t chunk_size = 4096;
+
+    ///input iterator over the elements of the file
+    class const_iterator {
+        std::shared_ptr<detail::chunked_reader<T>> reader;
+        std::size_t index = 0;
+
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T const*;
+        using reference = T const&;
+
+        const_iterator() = default;
+
+        const_iterator(std::string const& path, std::size_t index)
+            : reader(index == 0 ? std::make_shared<detail::chunked_reader<T>>(path, static_cast<std::size_t>(chunk_size), static_cast<long>(sizeof(detail::file_header))) : nullptr)
+            , index(index) {}
+
+        reference operator*() const {
+            return reader->head();
+        }
+
+        pointer operator->() const {
+            return &reader->head();
+        }
+
+        const_iterator& operator++() {
+            reader->advance();
+            ++index;
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator result = *this;
+            ++*this;
+            return result;
+        }
+
+        friend bool operator==(const_iterator const& a, const_iterator const& b) {
+            return a.index == b.index;
+        }
+
+        friend bool operator!=(const_iterator const& a, const_iterator const& b) {
+            return a.index != b.index;
+        }
+    };
+
+    SortedFile() = delete;
+
+    SortedFile(SortedFile const&) = default;
+    SortedFile(SortedFile&&) = default;
+    SortedFile& operator=(SortedFile const&) = default;
+    SortedFile& operator=(SortedFile&&) = default;
+
+    std::string const& path() const {
+        return filePath;
+    }
+
+    std::size_t size() const {
+        return n;
+    }
+
+    bool empty() const {
+        return n == 0;
+    }
+
+    ///opens the file, THROWS std::runtime_error
+    const_iterator begin() const {
+        return n == 0 ? end() : const_iterator(filePath, 0);
+    }
+
+    const_iterator end() const {
+        return const_iterator(filePath, n);
+    }
+
+    ///all elements in memory, without sorting them again. THROWS std::runtime_error
+    Sorted<std::vector<T>, Compare, Projection> load() const {
+        std::vector<T> result(n);
+        auto file = detail::open_file(filePath, "rb");
+        if (std::fseek(file.get(), static_cast<long>(sizeof(detail::file_header)), SEEK_SET) != 0 || std::fread(result.data(), sizeof(T), n, file.get()) != n)
+            throw std::runtime_error("flaggedT: couldn't read " + filePath);
+        return detail::access::make_trusted<Sorted<std::vector<T>, Compare, Projection>>(std::move(result));
+    }
+};
+
+//------------------------------------------------------------------------------
+
+///sorts more elements than fit into memory: pushed elements are collected until they take memoryBytes,
+///then sorted and spilled as run into a file within directory. finish() merges the runs into a SortedFile
+///merging reads the runs in chunks sharing the same memory, more than max_fan_in runs are merged in multiple passes
+///the run files are removed once merged or with the builder
+template <typename T, typename Compare, typename Projection>
+class SortedStreamBuilder {
+    static_assert(std::is_trivially_copyable<T>::value, "SortedStreamBuilder requires trivially copyable elements");
+
+public:
+    ///maximum number of runs merged at once
+    static constexpr std::size_t max_fan_in = 64;
+
+private:
+    std::string directory;
+    std::size_t capacity; //elements within memory
+    std::vector<T> buffer; //reserved to capacity at once, growing it geometrically would briefly take up to three times the memory
+    std::vector<std::string> runs;
+    std::size_t n = 0;
+
+public:
+    SortedStreamBuilder() = delete;
+
+    SortedStreamBuilder(SortedStreamBuilder const&) = delete;
+    SortedStreamBuilder(SortedStreamBuilder&&) = default;
+    SortedStreamBuilder& operator=(SortedStreamBuilder const&) = delete;
+    SortedStreamBuilder& operator=(SortedStreamBuilder&&) = delete;
+
+    SortedStreamBuilder(std::string directory, std::size_t memoryBytes)
+        : directory(std::move(directory))
+        , capacity(std::max<std::size_t>(memoryBytes / sizeof(T), 1)) {}
+
+    ~SortedStreamBuilder() {
+        remove_runs(runs.size());
+    }
+
+    ///THROWS std::runtime_error if a run can't be written
+    void push(T const& x) {
+        if (buffer.empty())
+            buffer.reserve(capacity); //no-op unless the buffer was released by finish()
+        buffer.push_back(x);
+        ++n;
+        if (buffer.size() >= capacity)
+            spill();
+    }
+
+    template <typename It>
+    void push(It first, It last) {
+        for (; first != last; ++first)
+            push(*first);
+    }
+
+    ///number of elements pushed
+    std::size_t size() const {
+        return n;
+    }
+
+    ///number of runs written to directory so far
+    std::size_t spilled_runs() const {
+        return runs.size();
+    }
+
+    ///memory taken by the buffer of pushed elements, never more than memoryBytes (or a single element)
+    std::size_t memory_bytes() const {
+        return buffer.capacity() * sizeof(T);
+    }
+
+    ///sorts all elements pushed into a file at path, the builder is empty afterwards. THROWS std::runtime_error
+    SortedFile<T, Compare, Projection> finish(std::string const& path) {
+        const std::size_t total = n;
+        if (runs.empty()) {
+            detail::sort_by<Compare, Projection>(buffer);
+            detail::file_writer<T> out(path, detail::file_sorted);
+            out.write(buffer.data(), buffer.size());
+            out.finish();
+        } else {
+            if (!buffer.empty())
+                spill();
+            while (runs.size() > max_fan_in) {
+                //the merged run is listed before merging, so it's removed as well should merging fail
+                runs.push_back(run_path());
+                detail::file_writer<T> out(runs.back(), detail::file_sorted, false);
+                merge(runs.begin(), runs.begin() + max_fan_in, out);
+                remove_runs(max_fan_in);
+            }
+            detail::file_writer<T> out(path, detail::file_sorted);
+            merge(runs.begin(), runs.end(), out);
+            remove_runs(runs.size());
+        }
+
+        buffer = std::vector<T>();
+        n = 0;
+        return SortedFile<T, Compare, Projection>(path, total);
+    }
+
+private:
+    ///new file within directory, created exclusively so concurrent builders can share the directory. THROWS std::runtime_error
+    std::string run_path() const {
+        static std::atomic<std::uint64_t> counter(0);
+        for (int attempt = 0; attempt < 100; ++attempt) {
+            std::string path = directory + "/flaggedT_run_" + std::to_string(reinterpret_cast<std::uintptr_t>(this)) + "_" + std::to_string(counter++);
+            if (detail::file_ptr file{ std::fopen(path.c_str(), "wbx") })
+                return path;
+        }
+        throw std::runtime_error("flaggedT: couldn't create a run file within " + directory);
+    }
+
+    void spill() {
+        detail::sort_by<Compare, Projection>(buffer);
+        runs.push_back(run_path());
+        detail::file_writer<T> out(runs.back(), detail::file_sorted, false);
+        out.write(buffer.data(), buffer.size());
+        out.finish();
+        buffer.clear();
+    }
+
+    ///removes the first count runs
+    void remove_runs(std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i)
+            std::remove(runs[i].c_str());
+        runs.erase(runs.begin(), runs.begin() + static_cast<std::ptrdiff_t>(count));
+    }
+
+    ///k-way merge via a heap of the runs ordered by their current element, finishes out
+    void merge(std::vector<std::string>::const_iterator first, std::vector<std::string>::const_iterator last, detail::file_writer<T>& out) {
+        const auto k = static_cast<std::size_t>(std::distance(first, last));
+        const std::size_t chunk = std::max<std::size_t>(capacity / (k + 1), 1);
+
+        std::vector<detail::chunked_reader<T>> readers;
+        readers.reserve(k);
+        for (; first != last; ++first)
+            readers.emplace_back(*first, chunk);
+
+        //heap order puts the run with the smallest current element first
+        std::vector<std::size_t> heap;
+        for (std::size_t r = 0; r < k; ++r)
+            if (!readers[r].done())
+                heap.push_back(r);
+        const auto later = [&readers](std::size_t a, std::size_t b) {
+            return Compare{}(Projection{}(readers[b].head()), Projection{}(readers[a].head()));
+        };
+        std::make_heap(heap.begin(), heap.end(), later);
+
+        std::vector<T> merged;
+        merged.reserve(chunk);
+        while (!heap.empty()) {
+            std::pop_heap(heap.begin(), heap.end(), later);
+            auto& reader = readers[heap.back()];
+            merged.push_back(reader.head());
+            if (merged.size() == chunk) {
+                out.write(merged.data(), merged.size());
+                merged.clear();
+            }
+
+            reader.advance();
+            if (reader.done())
+                heap.pop_back();
+            else
+                std::push_heap(heap.begin(), heap.end(), later);
+        }
+        out.write(merged.data(), merged.size());
+        out.finish();
+    }
+};
+
+//------------------------------------------------------------------------------
+
+///how the views establish the flags of a file, its header is always checked to match the element type
+enum class Verification {
+    Order,    ///checks the flags on the elements themselves (e.g. the order of all adjacent pairs), O(n), the only one which doesn't rely on the header
+    Checksum, ///trusts the flags of the header once the elements match its checksum, O(n) without any comparison
+    Trusted   ///trusts the flags of the header, O(1)
+};
+
+namespace detail {
+
+///read only mapping of a whole file, read into memory instead where mmap isn't available
+class mapped_file {
+    unsigned char const* address = nullptr;
+    std::size_t length = 0;
+#ifndef FLAGGEDT_HAS_MMAP
+    std::vector<std::uint64_t> copy;
+#endif
+
+public:
+    ///THROWS std::runtime_error
+    explicit mapped_file(std::string const& path) {
+#ifdef FLAGGEDT_HAS_MMAP
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw std::runtime_error("flaggedT: couldn't open " + path);
+
+        struct stat info;
+        const bool known = ::fstat(fd, &info) == 0;
+        length = known ? static_cast<std::size_t>(info.st_size) : 0;
+        void* p = known && length > 0 ? ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0) : nullptr;
+        ::close(fd); //the mapping stays valid
+        if (!known || p == MAP_FAILED)
+            throw std::runtime_error("flaggedT: couldn't map " + path);
+        address = static_cast<unsigned char const*>(p);
+#else
+        auto file = open_file(path, "rb");
+        const long size = std::fseek(file.get(), 0, SEEK_END) == 0 ? std::ftell(file.get()) : -1;
+        if (size < 0 || std::fseek(file.get(), 0, SEEK_SET) != 0)
+            throw std::runtime_error("flaggedT: couldn't read " + path);
+        length = static_cast<std::size_t>(size);
+        copy.resize((length + 7) / 8);
+        if (std::fread(copy.data(), 1, length, file.get()) != length)
+            throw std::runtime_error("flaggedT: couldn't read " + path);
+        address = reinterpret_cast<unsigned char const*>(copy.data());
+#endif
+    }
+
+    ~mapped_file() {
+#ifdef FLAGGEDT_HAS_MMAP
+        if (address)
+            ::munmap(const_cast<unsigned char*>(address), length);
+#endif
+    }
+
+    mapped_file(mapped_file const&) = delete;
+    mapped_file& operator=(mapped_file const&) = delete;
+
+    unsigned char const* data() const {
+        return address;
+    }
+
+    std::size_t size() const {
+        return length;
+    }
+};
+
+///contiguous elements owned elsewhere, searched like a container
+template <typename T>
+class array_view {
+    T const* first = nullptr;
+    T const* last = nullptr;
+
+public:
+    array_view() = default;
+
+    array_view(T const* first, std::size_t n)
+        : first(first)
+        , last(first + n) {}
+
+    T const* begin() const {
+        return first;
+    }
+
+    T const* end() const {
+        return last;
+    }
+
+    std::size_t size() const {
+        return static_cast<std::size_t>(last - first);
+    }
+
+    T const& operator[](std::size_t i) const {
+        return first[i];
+    }
+};
+
+///header of a mapped file of elements of T. THROWS std::runtime_error if the file doesn't match T
+template <typename T>
+file_header mapped_header(mapped_file const& file, std::string const& path) {
+    file_header header;
+    const bool matches = file.size() >= sizeof(header)
+        && (std::memcpy(&header, file.data(), sizeof(header)), std::memcmp(header.magic, "FLAGGEDT", sizeof(header.magic)) == 0)
+        && header.version == 1
+        && header.elementSize == sizeof(T)
+        && header.count == (file.size() - sizeof(header)) / sizeof(T)
+        && (file.size() - sizeof(header)) % sizeof(T) == 0;
+    if (!matches)
+        throw std::runtime_error("flaggedT: " + path + " isn't a file of elements of " + std::to_string(sizeof(T)) + " bytes");
+    return header;
+}
+
+///THROWS std::runtime_error if the elements following header don't match its checksum
+inline void verify_checksum(file_header const& header, void const* elements, std::string const& path) {
+    if (checksum_of(elements, static_cast<std::size_t>(header.count * header.elementSize)) != header.checksum)
+        throw std::runtime_error("flaggedT: " + path + " doesn't match its checksum");
+}
+
+///elements of a mapped file of elements of T, whose header has to record the flags required unless they're verified by their order
+///THROWS std::runtime_error if the file doesn't match T or its checksum, FlaggedTError if the header misses required flags
+template <typename T>
+array_view<T> mapped_elements(mapped_file const& file, std::string const& path, Verification verification, std::uint32_t required, FlagKind kind) {
+    const file_header header = mapped_header<T>(file, path);
+    unsigned char const* elements = file.data() + sizeof(header);
+
+    if (verification == Verification::Checksum)
+        verify_checksum(header, elements, path);
+
+    if (verification != Verification::Order && checks_enabled()) {
+        if (!(header.flags & file_sorted))
+            violated(FlaggedTError("The header of the file passed to the view doesn't record it as sorted", kind, Violation::NotSorted));
+        if ((required & file_unique) && !(header.flags & file_unique))
+            violated(FlaggedTError("The header of the file passed to the view doesn't record it as unique", kind, Violation::Duplicate));
+    }
+
+    return array_view<T>(reinterpret_cast<T const*>(elements), static_cast<std::size_t>(header.count));
+}
+
+template <typename E>
+void write_all(file_writer<E>& out, std::vector<E> const& data) {
+    out.write(data.data(), data.size());
+}
+
+template <typename E, typename T>
+void write_all(file_writer<E>& out, T const& data) {
+    std::vector<E> chunk;
+    chunk.reserve(4096);
+    for (auto const& x : data) {
+        chunk.push_back(x);
+        if (chunk.size() == chunk.capacity()) {
+            out.write(chunk.data(), chunk.size());
+            chunk.clear();
+        }
+    }
+    out.write(chunk.data(), chunk.size());
+}
+
+///writes the elements of data after a header with flags. THROWS std::runtime_error
+template <typename T>
+void save_elements(T const& data, std::string const& path, std::uint32_t flags) {
+    using E = element_t<T>;
+    static_assert(std::is_trivially_copyable<E>::value, "save requires trivially copyable elements");
+
+    file_writer<E> out(path, flags);
+    write_all(out, data);
+    out.finish();
+}
+
+///container T holding the loaded elements
+template <typename T, typename E>
+struct container_of {
+    static T from(std::vector<E>&& elements) {
+        return T(elements.begin(), elements.end());
+    }
+};
+
+template <typename E>
+struct container_of<std::vector<E>, E> {
+    static std::vector<E> from(std::vector<E>&& elements) {
+        return std::move(elements);
+    }
+};
+
+template <typename E, std::size_t N>
+struct container_of<std::array<E, N>, E> {
+    ///THROWS std::runtime_error
+    static std::array<E, N> from(std::vector<E>&& elements) {
+        if (elements.size() != N)
+            throw std::runtime_error("flaggedT: the file doesn't hold " + std::to_string(N) + " elements");
+        std::array<E, N> result;
+        std::copy(elements.begin(), elements.end(), result.begin());
+        return result;
+    }
+};
+
+///file flag recording that each element is valid for Flag, flags without one are always verified by load()
+template <typename Flag>
+struct element_file_flag : std::integral_constant<std::uint32_t, 0> {};
+
+template <typename T>
+struct element_file_flag<Positive<T>> : std::integral_constant<std::uint32_t, file_positive> {};
+
+///how save() and load() handle the flagged type X: the file flags recording its flag, holds() checks the flag on the elements in O(n)
+///make() creates X from the elements, through its constructor unless they're trusted
+template <typename X>
+struct file_format {
+    static_assert(sizeof(X) == 0, "save and load support Sorted, UniqueAndSorted, Unique, FixedSized and FlaggedArray");
+};
+
+template <typename T, typename Compare, typename Projection>
+struct file_format<Sorted<T, Compare, Projection>> {
+    using X = Sorted<T, Compare, Projection>;
+    using element_type = element_t<T>;
+
+    static constexpr std::uint32_t flags() {
+        return file_sorted;
+    }
+
+    static bool holds(element_type const* data, std::size_t n) {
+        return all_pairs(data, n, [](element_type const& a, element_type const& b) {
+            return !Compare{}(Projection{}(b), Projection{}(a));
+        });
+    }
+
+    static X make(std::vector<element_type>&& elements, bool trusted) {
+        T data = container_of<T, element_type>::from(std::move(elements));
+        return trusted ? access::make_trusted<X>(std::move(data)) : X(std::move(data));
+    }
+};
+
+template <typename T, typename Compare, typename Projection>
+struct file_format<UniqueAndSorted<T, Compare, Projection>> {
+    using X = UniqueAndSorted<T, Compare, Projection>;
+    using element_type = element_t<T>;
+
+    static constexpr std::uint32_t flags() {
+        return file_sorted | file_unique;
+    }
+
+    static bool holds(element_type const* data, std::size_t n) {
+        return all_pairs(data, n, [](element_type const& a, element_type const& b) {
+            return Compare{}(Projection{}(a), Projection{}(b));
+        });
+    }
+
+    static X make(std::vector<element_type>&& elements, bool trusted) {
+        T data = container_of<T, element_type>::from(std::move(elements));
+        return trusted ? access::make_trusted<X>(std::move(data)) : X(std::move(data));
+    }
+};
+
+template <typename T>
+struct file_format<Unique<T>> {
+    using X = Unique<T>;
+    using element_type = element_t<T>;
+
+    static constexpr std::uint32_t flags() {
+        return file_unique;
+    }
+
+    static bool holds(element_type const* data, std::size_t n) {
+        return all_pairs(data, n, [](element_type const& a, element_type const& b) {
+            return !(a == b);
+        });
+    }
+
+    static X make(std::vector<element_type>&& elements, bool trusted) {
+        T data = container_of<T, element_type>::from(std::move(elements));
+        return trusted ? access::make_trusted<X>(std::move(data)) : X(std::move(data));
+    }
+};
+
+///the size is checked against the count of the header instead of a flag, always in O(1)
+template <typename T, std::size_t SIZE>
+struct file_format<FixedSized<T, SIZE>> {
+    using X = FixedSized<T, SIZE>;
+    using element_type = element_t<T>;
+
+    static constexpr std::uint32_t flags() {
+        return 0;
+    }
+
+    static bool holds(element_type const*, std::size_t n) {
+        return n == SIZE;
+    }
+
+    static X make(std::vector<element_type>&& elements, bool) {
+        return X(container_of<T, element_type>::from(std::move(elements)));
+    }
+};
+
+template <typename Flag>
+struct file_format<FlaggedArray<Flag>> {
+    using X = FlaggedArray<Flag>;
+    using element_type = typename Flag::wrapped_type;
+
+    static constexpr std::uint32_t flags() {
+        return element_file_flag<Flag>::value;
+    }
+
+    static bool holds(element_type const* data, std::size_t n) {
+        return all_chunks(n, [data](std::size_t begin, std::size_t end) {
+            return X::all_valid(data + begin, end - begin);
+        });
+    }
+
+    static X make(std::vector<element_type>&& elements, bool trusted) {
+        return trusted ? access::make_trusted<X>(std::move(elements)) : X(std::move(elements));
+    }
+};
+
+}
+
+//------------------------------------------------------------------------------
+
+///writes the elements of data after a header which records its flag, to be read by load() (or mapped by SortedView if sorted)
+///supports Sorted, UniqueAndSorted, Unique, FixedSized and FlaggedArray of trivially copyable elements. THROWS std::runtime_error
+template <typename X>
+void save(X const& data, std::string const& path) {
+    detail::save_elements(data.get(), path, detail::file_format<X>::flags());
+}
+
+///flagged data of type X, written by save()
+///the flag is trusted if the header records it (Verification::Trusted) and the elements also match its checksum (Verification::Checksum), skipping e.g. the sort of Sorted
+///Verification::Order checks the flag on the elements in O(n) instead, on FLAGGEDT_PARALLEL_THREADS threads with FLAGGEDT_PARALLEL
+///elements whose flag isn't trusted or doesn't hold are passed to the constructor of X, which establishes the flag (or reports its violation) as usual
+///the header records the element size only, the element type, Compare and Projection have to match those the file was written with
+///THROWS std::runtime_error if the file can't be read, doesn't match the element size or (Verification::Checksum) its checksum
+template <typename X>
+X load(std::string const& path, Verification verification = Verification::Order) {
+    using format = detail::file_format<X>;
+    using E = typename format::element_type;
+    static_assert(std::is_trivially_copyable<E>::value, "load requires trivially copyable elements");
+
+    const detail::mapped_file file(path);
+    const detail::file_header header = detail::mapped_header<E>(file, path);
+    auto first = reinterpret_cast<E const*>(file.data() + sizeof(header));
+    const auto n = static_cast<std::size_t>(header.count);
+
+    bool trusted = format::flags() != 0 && (header.flags & format::flags()) == format::flags();
+    if (verification == Verification::Checksum)
+        detail::verify_checksum(header, first, path);
+    else if (verification == Verification::Order)
+        trusted = format::holds(first, n);
+
+    return format::make(std::vector<E>(first, first + n), trusted);
+}
+
+//------------------------------------------------------------------------------
+
+///read only view of the elements of a file written by save() or SortedStreamBuilder, mapped into memory instead of loading and sorting them again
+///see Verification for how the order is established. The header can't record Compare and Projection, they have to match those the file was written with
+///all searches of Sorted work on the mapped elements, the mapping lives as long as any copy of the view
+template <typename T, typename Compare, typename Projection>
+class SortedView {
+    static_assert(std::is_trivially_copyable<T>::value, "SortedView requires trivially copyable elements");
+    static_assert(std::is_default_constructible<Compare>::value && std::is_default_constructible<Projection>::value, "SortedView requires default constructible Compare and Projection");
+
+    using view = detail::array_view<T>;
+    using search = detail::sorted_search<view, Compare, Projection>;
+
+    std::shared_ptr<detail::mapped_file> file;
+    view data;
+
+protected:
+    ///THROWS std::runtime_error if the file can't be read or doesn't match T, FlaggedTError if the flags can't be established
+    SortedView(std::string const& path, Verification verification, bool unique)
+        : file(std::make_shared<detail::mapped_file>(path))
+        , data(detail::mapped_elements<T>(*file, path, verification,
+              unique ? detail::file_sorted | detail::file_unique : detail::file_sorted,
+              unique ? FlagKind::UniqueAndSorted : FlagKind::Sorted)) {
+
+        if (verification == Verification::Order && detail::checks_enabled())
+            verify_order(unique);
+    }
+
+public:
+    using key_compare = Compare;
+    using projection = Projection;
+    using key_type = typename search::key_type;
+    using const_iterator = T const*;
+
+    SortedView() = delete;
+
+    SortedView(SortedView const&) = default;
+    SortedView(SortedView&&) = default;
+    SortedView& operator=(SortedView const&) = default;
+    SortedView& operator=(SortedView&&) = default;
+
+    ///THROWS std::runtime_error if the file can't be read or doesn't match T, FlaggedTError if it isn't sorted
+    explicit SortedView(std::string const& path, Verification verification = Verification::Order)
+        : SortedView(path, verification, false) {}
+
+    ///the file is sorted by construction. THROWS std::runtime_error if it can't be read
+    explicit SortedView(SortedFile<T, Compare, Projection> const& sorted)
+        : SortedView(sorted.path(), Verification::Trusted, false) {}
+
+    std::size_t size() const {
+        return data.size();
+    }
+
+    bool empty() const {
+        return data.size() == 0;
+    }
+
+    const_iterator begin() const {
+        return data.begin();
+    }
+
+    const_iterator end() const {
+        return data.end();
+    }
+
+    T const& operator[](std::size_t i) const {
+        return data[i];
+    }
+
+    ///position of the first element whose key isn't ordered before key
+    std::size_t rank(key_type const& key) const {
+        return search::lower(data, key);
+    }
+
+    ///rank of each key within [keys, keysEnd) written to out, interleaves the searches to hide memory latency
+    template <typename KeyIt, typename OutIt>
+    void ranks(KeyIt keys, KeyIt keysEnd, OutIt out) const {
+        search::lower_batch(data, keys, keysEnd, out);
+    }
+
+    ///first element whose key isn't ordered before key
+    const_iterator lower_bound(key_type const& key) const {
+        return search::at(data, search::lower(data, key));
+    }
+
+    ///first element whose key is ordered after key
+    const_iterator upper_bound(key_type const& key) const {
+        return search::at(data, search::upper(data, key));
+    }
+
+    std::pair<const_iterator, const_iterator> equal_range(key_type const& key) const {
+        return std::make_pair(lower_bound(key), upper_bound(key));
+    }
+
+    bool contains(key_type const& key) const {
+        return search::contains(data, key);
+    }
+
+private:
+    ///the first element which isn't ordered after its predecessor is reported as value() of the error
+    void verify_order(bool unique) const {
+        const std::size_t n = data.size();
+        for (std::size_t i = 1; i < n; ++i) {
+            auto const& previous = Projection{}(data[i - 1]);
+            auto const& current = Projection{}(data[i]);
+            if (Compare{}(current, previous))
+                detail::violated(FlaggedTError("Elements of the file passed to the view aren't sorted", unique ? FlagKind::UniqueAndSorted : FlagKind::Sorted, Violation::NotSorted, static_cast<double>(i)));
+            if (unique && !Compare{}(previous, current))
+                detail::violated(FlaggedTError("Elements of the file passed to the view aren't unique", FlagKind::UniqueAndSorted, Violation::Duplicate, static_cast<double>(i)));
+        }
+    }
+};
+
+//------------------------------------------------------------------------------
+
+///SortedView of a file whose elements are also unique, elements with equivalent keys are duplicates
+template <typename T, typename Compare, typename Projection>
+class UniqueAndSortedView : public SortedView<T, Compare, Projection> {
+    using base = SortedView<T, Compare, Projection>;
+
+public:
+    UniqueAndSortedView() = delete;
+
+    UniqueAndSortedView(UniqueAndSortedView const&) = default;
+    UniqueAndSortedView(UniqueAndSortedView&&) = default;
+    UniqueAndSortedView& operator=(UniqueAndSortedView const&) = default;
+    UniqueAndSortedView& operator=(UniqueAndSortedView&&) = default;
+
+    ///THROWS std::runtime_error if the file can't be read or doesn't match T, FlaggedTError if it isn't unique and sorted
+    explicit UniqueAndSortedView(std::string const& path, Verification verification = Verification::Order)
+        : base(path, verification, true) {}
+};
+}
+
+#endif // FLAGGEDT_FILE_H
@@ -0,0 +1,159 @@
+/*
+    Copyright (c) 2016 Martin Buck
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//forward declarations of all flagged types, e.g. for function declarations within headers
+
+#ifndef FLAGGEDT_FWD_H
+#define FLAGGEDT_FWD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+
+///defined as export by flaggedT.cppm, which includes the headers within the module purview
+#ifndef FLAGGEDT_EXPORT
+    #define FLAGGEDT_EXPORT
+#endif
+
+FLAGGEDT_EXPORT namespace flaggedT {
+
+//------------------------------------------------------------------------------
+
+class FlaggedTError;
+
+///projection of Sorted and UniqueAndSorted which uses the elements themselves as keys
+struct identity {
+    template <typename U>
+    constexpr U&& operator()(U&& in) const noexcept {
+        return std::forward<U>(in);
+    }
+};
+
+template <typename T>
+class FlaggedTBase;
+
+template <typename T>
+class Immutable;
+
+template <typename T>
+class shared_im;
+
+template <typename T>
+class NonNull;
+
+template <typename T, typename Compare = std::less<>, typename Projection = identity>
+class Sorted;
+
+template <typename T, typename Compare = std::less<>, typename Projection = identity>
+class SortedIndex;
+
+template <typename T, std::size_t EPSILON = 64, typename Projection = identity>
+class LearnedIndex;
+
+template <typename T>
+class CompressedSortedSet;
+
+class RoaringBitmap;
+
+template <typename T, int64_t MIN, int64_t MAX>
+class BoundedSet;
+
+template <typename T, typename Compare = std::less<>, typename Projection = identity>
+class BloomFiltered;
+
+template <typename T, typename Compare = std::less<>, typename Projection = identity>
+class SortedFile;
+
+template <typename T, typename Compare = std::less<>, typename Projection = identity>
+class SortedStreamBuilder;
+
+template <typename T, typename Compare = std::less<>, typename Projection = identity>
+class SortedView;
+
+template <typename T, typename Compare = std::less<>, typename Projection = identity>
+class UniqueAndSortedView;
+
+template <typename T>
+class Shuffled;
+
+template <typename T>
+class Unique;
+
+template <typename T, typename Compare = std::less<>, typename Projection = identity>
+class UniqueAndSorted;
+
+template <typename T>
+class NonZero;
+
+template <typename T>
+class Positive;
+
+template <typename T>
+class Negative;
+
+template <typename T>
+class PowerOfTwo;
+
+template <typename T>
+class NonPositive;
+
+template <typename T>
+class NonNegative;
+
+template <typename T, int64_t MAX>
+class CeiledInclusive;
+
+template <typename T, int64_t MAX>
+class CeiledExclusive;
+
+template <typename T, int64_t MIN>
+class FlooredInclusive;
+
+template <typename T, int64_t MIN>
+class FlooredExclusive;
+
+template <typename T, int64_t MIN, int64_t MAX>
+class BoundedInclusive;
+
+template <typename T, int64_t MIN, int64_t MAX>
+class BoundedExclusive;
+
+template <typename T>
+class NonEmpty;
+
+template <typename T, std::size_t SIZE>
+class MoreThan;
+
+template <typename T, std::size_t SIZE>
+class LessThan;
+
+template <typename T, std::size_t SIZE>
+class FixedSized;
+
+template <typename T, std::size_t MINSIZE, std::size_t MAXSIZE>
+class FixedRangeInclusive;
+
+template <typename Flag>
+class FlaggedArray;
+
+#ifndef FLAGGEDT_NO17
+
+template <typename... Types>
+class EqualSized;
+
+#endif
+
+}
+
+#endif // FLAGGEDT_FWD_H
@@ -0,0 +1,89 @@
+/*
+    Copyright (c) 2016 Martin Buck
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//Immutable and shared_im
+
+#ifndef FLAGGEDT_IMMUTABLE_H
+#define FLAGGEDT_IMMUTABLE_H
+
+#include <memory>
+#include <utility>
+
+#include "flaggedT_base.h"
+
+FLAGGEDT_EXPORT namespace flaggedT {
+
+//------------------------------------------------------------------------------
+
+template <typename T>
+class Immutable final : public FlaggedTBase<T> {
+    using base = FlaggedTBase<T>;
+public:
+
+    constexpr Immutable(T const& in)
+        : base(in) {}
+
+    constexpr Immutable(T&& in)
+        : base(std::forward<T>(in)) {}
+
+    Immutable() = delete;
+
+    Immutable(Immutable const&) = default;
+    Immutable(Immutable &&) = default;
+    Immutable& operator=(Immutable const&) = default;
+    Immutable& operator=(Immutable &&) = default;
+};
+
+//------------------------------------------------------------------------------
+
+template <typename T>
+class shared_im final {
+    std::shared_ptr<Immutable<T>> ptr;
+
+public:
+
+    shared_im(T const& in) {
+        ptr = std::make_shared<Immutable<T>>(in);
+    }
+
+    shared_im(T&& in) {
+        ptr = std::make_shared<Immutable<T>>(std::forward<T>(in));
+    }
+
+    shared_im() = delete;
+    shared_im(shared_im const&) = default;
+    shared_im(shared_im &&) = default;
+    shared_im& operator=(shared_im const&) = default;
+    shared_im& operator=(shared_im &&) = default;
+
+
+    T const& get() const {
+        return ptr->get();
+    }
+
+    T&& unwrap() && {
+        return std::move(ptr->get());
+    }
+
+    operator T const& () const {
+        return ptr->get();
+    }
+
+    operator T&& () && {
+        return std::move(ptr->get());
+    }
+};
+
+}
+
+#endif // FLAGGEDT_IMMUTABLE_H
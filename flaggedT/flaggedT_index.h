@@ -0,0 +1,401 @@
+/*
+    Copyright (c) 2016 Martin Buck
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+//search structures built over Sorted data
+
+#ifndef FLAGGEDT_INDEX_H
+#define FLAGGEDT_INDEX_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "flaggedT_ordering.h"
+
+FLAGGEDT_EXPORT namespace flaggedT {
+
+//------------------------------------------------------------------------------
+
+namespace detail {
+
+///k of the Eytzinger search after dropping its trailing right turns (1 bits) and the final left turn
+inline std::size_t eytzinger_resolve(std::size_t k) {
+#if defined(__GNUC__) || defined(__clang__)
+    return k >> __builtin_ffsll(static_cast<long long>(~k));
+#else
+    while (k & 1)
+        k >>= 1;
+    return k >> 1;
+#endif
+}
+
+///floor(log2(k)) for k > 0, the depth of node k
+inline unsigned eytzinger_depth(std::size_t k) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(sizeof(unsigned long long) * 8 - 1 - __builtin_clzll(static_cast<unsigned long long>(k)));
+#else
+    unsigned d = 0;
+    while (k >>= 1)
+        ++d;
+    return d;
+#endif
+}
+
+
+///x - from as double, exact for integers as long as the distance fits 53 bits (x >= from)
+template <typename K>
+double key_distance(K const& x, K const& from, std::true_type /*integral*/) {
+    using U = typename std::make_unsigned<K>::type;
+    return static_cast<double>(static_cast<U>(static_cast<U>(x) - static_cast<U>(from)));
+}
+
+template <typename K>
+double key_distance(K const& x, K const& from, std::false_type /*integral*/) {
+    return static_cast<double>(x - from);
+}
+
+template <typename K>
+double key_distance(K const& x, K const& from) {
+    return key_distance(x, from, std::is_integral<K>{});
+}
+
+///partition point of pred within [first, first + n), expected within pos +- eps
+///the window grows exponentially should the expectation be wrong, so the result is always exact
+template <typename It, typename Pred>
+std::size_t window_search(It first, std::size_t n, std::size_t pos, std::size_t eps, Pred pred) {
+    pos = pos < n ? pos : n;
+    std::size_t a = pos > eps ? pos - eps : 0;
+    std::size_t b = n - pos > eps ? pos + eps + 1 : n;
+
+    //the whole window is loaded at once, instead of one cache line per step of the search
+    const std::size_t stride = 64 / sizeof(first[0]) > 0 ? 64 / sizeof(first[0]) : 1;
+    for (std::size_t i = a; i < b; i += stride)
+        prefetch(&first[i]);
+
+    std::size_t step = eps + 1;
+    while (a > 0 && !pred(first[a - 1])) {
+        b = a - 1;
+        a = a > step ? a - step : 0;
+        step *= 2;
+    }
+    while (b < n && pred(first[b])) {
+        a = b + 1;
+        b = n - b > step ? b + step : n;
+        step *= 2;
+    }
+    return a + partition_pos(first + static_cast<std::ptrdiff_t>(a), b - a, pred);
+}
+
+///line through the positions of the keys from first on, within +- epsilon of each of them
+template <typename K>
+struct segment {
+    K first;
+    double slope;
+    std::size_t start;
+
+    ///position of key within [start, n], n being the number of positions indexed
+    ///clamped before the conversion, as keys far past the line (or NaN) don't fit std::size_t
+    std::size_t predict(K const& key, std::size_t n) const {
+        if (key < first)
+            return start;
+        const double offset = slope * key_distance(key, first);
+        if (!(offset > 0))
+            return start;
+        if (offset >= static_cast<double>(n - start))
+            return n;
+        return start + static_cast<std::size_t>(offset);
+    }
+};
+
+///greedy piecewise linear approximation of the sorted points with a maximum error of eps (shrinking cone)
+///next(key, pos) yields the points one after another and returns false once there are none left, so they needn't be stored
+template <typename K, typename Next>
+std::vector<segment<K>> approximate(Next next, double eps) {
+    std::vector<segment<K>> result;
+    K key{};
+    std::size_t pos = 0;
+    bool more = next(key, pos);
+    while (more) {
+        //the point which ended the previous line starts the next one
+        const K x0 = key;
+        const std::size_t start = pos;
+        const double y0 = static_cast<double>(pos);
+        double lo = 0;
+        double hi = std::numeric_limits<double>::infinity();
+
+        while ((more = next(key, pos))) {
+            const double dx = key_distance(key, x0);
+            const double y = static_cast<double>(pos);
+            const double newLo = std::max(lo, (y - eps - y0) / dx);
+            const double newHi = std::min(hi, (y + eps - y0) / dx);
+            if (newLo > newHi)
+                break;
+            lo = newLo;
+            hi = newHi;
+        }
+
+        const double slope = hi == std::numeric_limits<double>::infinity() ? lo : (lo + hi) / 2;
+        result.push_back(segment<K>{ x0, slope, start });
+    }
+    return result;
+}
+
+}
+
+//------------------------------------------------------------------------------
+
+///Sorted data plus a copy of its keys in Eytzinger (breadth first) order for cache friendly searches
+///the first levels of the tree share few cache lines and descendants are prefetched, so a search has far fewer cache misses than std::lower_bound on large data
+///the tree is perfect (2^h - 1 nodes, padded with the largest key), so positions follow from the node index without another memory access
+///the sorted data stays available via get() and SortedIndex can be passed as Sorted
+template <typename T, typename Compare, typename Projection>
+class SortedIndex : public Sorted<T, Compare, Projection> {
+    using base = Sorted<T, Compare, Projection>;
+
+public:
+    using typename base::key_type;
+    using typename base::const_iterator;
+
+private:
+    ///keys per cache line, the descendants log2(prefetch_stride) levels below k are the keys from k * prefetch_stride on
+    static constexpr std::size_t prefetch_stride = 64 / sizeof(key_type) > 0 ? 64 / sizeof(key_type) : 1;
+
+    std::vector<key_type> tree; //1 based, tree[0] unused
+    std::size_t n = 0;
+    unsigned height = 0;
+
+public:
+    SortedIndex() = delete;
+
+    SortedIndex(SortedIndex const&) = default;
+    SortedIndex(SortedIndex&&) = default;
+    SortedIndex& operator=(SortedIndex const&) = default;
+    SortedIndex& operator=(SortedIndex&&) = default;
+
+    SortedIndex(T&& in)
+        : base(std::forward<T>(in)) {
+
+        build();
+    }
+
+    ///only builds the index, the data is already sorted
+    SortedIndex(base in)
+        : base(std::move(in)) {
+
+        build();
+    }
+
+    std::size_t size() const {
+        return n;
+    }
+
+    ///position of the first element whose key isn't ordered before key
+    std::size_t rank(key_type const& key) const {
+        return position(search(key));
+    }
+
+    ///first element whose key isn't ordered before key
+    const_iterator lower_bound(key_type const& key) const {
+        return std::next(std::begin(base::get()), static_cast<std::ptrdiff_t>(rank(key)));
+    }
+
+    bool contains(key_type const& key) const {
+        const std::size_t k = search(key);
+        return position(k) != n && !Compare{}(key, tree[k]);
+    }
+
+private:
+    ///Eytzinger index of the lower bound of key, 0 if there's none
+    std::size_t search(key_type const& key) const {
+        const std::size_t m = tree.size() - 1;
+        const key_type* t = tree.data();
+        std::size_t k = 1;
+        while (k <= m) {
+            //descendants might lie beyond the tree, prefetching them has no effect then
+            detail::prefetch(reinterpret_cast<void const*>(reinterpret_cast<std::uintptr_t>(t) + k * prefetch_stride * sizeof(key_type)));
+            k = 2 * k + static_cast<std::size_t>(Compare{}(t[k], key));
+        }
+        return detail::eytzinger_resolve(k);
+    }
+
+    ///in order position of node k within the perfect tree, n for k == 0 and the padding
+    std::size_t position(std::size_t k) const {
+        if (k == 0)
+            return n;
+        const unsigned d = detail::eytzinger_depth(k);
+        const std::size_t p = k - (std::size_t(1) << d);
+        const std::size_t pos = ((2 * p + 1) << (height - 1 - d)) - 1;
+        return pos < n ? pos : n;
+    }
+
+    void build() {
+        auto first = std::begin(base::get());
+        n = static_cast<std::size_t>(std::distance(first, std::end(base::get())));
+
+        height = 0;
+        while ((std::size_t(1) << height) - 1 < n)
+            ++height;
+
+        tree.clear();
+        if (n == 0) {
+            tree.resize(1, key_type());
+            return;
+        }
+        tree.resize(std::size_t(1) << height, Projection{}(first[n - 1]));
+
+        //in order traversal of the implicit tree assigns the sorted keys, depth is log2(n)
+        std::size_t i = 0;
+        build(first, i, 1);
+    }
+
+    template <typename It>
+    void build(It first, std::size_t& i, std::size_t k) {
+        if (k >= tree.size() || i >= n)
+            return;
+        build(first, i, 2 * k);
+        if (i < n)
+            tree[k] = Projection{}(first[i++]);
+        build(first, i, 2 * k + 1);
+    }
+};
+
+//------------------------------------------------------------------------------
+
+///Sorted data of numeric keys plus a learned index, which approximates the position of each key by a piecewise linear function (as the PGM-index)
+///each line predicts the position within +- EPSILON, the lines are indexed the same way recursively until a single one is left
+///a lookup costs one prediction per level and a search over 2 * EPSILON + 1 elements, the index takes at most one line per EPSILON elements
+template <typename T, std::size_t EPSILON, typename Projection>
+class LearnedIndex : public Sorted<T, std::less<>, Projection> {
+    using base = Sorted<T, std::less<>, Projection>;
+
+public:
+    using typename base::key_type;
+    using typename base::const_iterator;
+
+private:
+    static_assert(std::is_arithmetic<key_type>::value, "LearnedIndex requires numeric keys");
+    static_assert(EPSILON > 0, "LearnedIndex requires EPSILON > 0");
+
+    ///maximum error of the lines indexing lines
+    static constexpr std::size_t epsilon_levels = 4;
+
+    using segment = detail::segment<key_type>;
+
+    std::vector<std::vector<segment>> levels; //levels[0] indexes the data, the last level consists of a single line
+
+public:
+    LearnedIndex() = delete;
+
+    LearnedIndex(LearnedIndex const&) = default;
+    LearnedIndex(LearnedIndex&&) = default;
+    LearnedIndex& operator=(LearnedIndex const&) = default;
+    LearnedIndex& operator=(LearnedIndex&&) = default;
+
+    LearnedIndex(T&& in)
+        : base(std::forward<T>(in)) {
+
+        build();
+    }
+
+    ///only builds the index, the data is already sorted
+    LearnedIndex(base in)
+        : base(std::move(in)) {
+
+        build();
+    }
+
+    ///number of lines within all levels
+    std::size_t segments() const {
+        std::size_t result = 0;
+        for (auto const& level : levels)
+            result += level.size();
+        return result;
+    }
+
+    ///position of the first element whose key isn't smaller than key
+    std::size_t rank(key_type const& key) const {
+        auto first = std::begin(base::get());
+        const auto n = static_cast<std::size_t>(std::distance(first, std::end(base::get())));
+        if (n == 0)
+            return 0;
+
+        std::size_t s = 0;
+        for (std::size_t l = levels.size() - 1; l > 0; --l) {
+            std::vector<segment> const& below = levels[l - 1];
+            //one past the last line below which starts at or before key
+            const std::size_t after = detail::window_search(below.begin(), below.size(), levels[l][s].predict(key, below.size()) + 1, epsilon_levels + 1, [&key](segment const& x) {
+                return !(key < x.first);
+            });
+            s = after > 0 ? after - 1 : 0;
+        }
+
+        return detail::window_search(first, n, levels[0][s].predict(key, n), EPSILON, [&key](detail::element_t<T> const& x) {
+            return Projection{}(x) < key;
+        });
+    }
+
+    ///first element whose key isn't smaller than key
+    const_iterator lower_bound(key_type const& key) const {
+        return std::next(std::begin(base::get()), static_cast<std::ptrdiff_t>(rank(key)));
+    }
+
+    bool contains(key_type const& key) const {
+        auto it = lower_bound(key);
+        return it != std::end(base::get()) && !(key < Projection{}(*it));
+    }
+
+private:
+    void build() {
+        levels.clear();
+
+        auto first = std::begin(base::get());
+        const auto n = static_cast<std::size_t>(std::distance(first, std::end(base::get())));
+        if (n == 0)
+            return;
+
+        //the first occurrence of each key, found while approximating instead of storing the positions of all of them
+        std::size_t i = 0;
+        levels.push_back(detail::approximate<key_type>([&](key_type& key, std::size_t& pos) {
+            while (i > 0 && i < n && !(Projection{}(first[i - 1]) < Projection{}(first[i])))
+                ++i;
+            if (i == n)
+                return false;
+            key = static_cast<key_type>(Projection{}(first[i]));
+            pos = i++;
+            return true;
+        }, static_cast<double>(EPSILON)));
+
+        while (levels.back().size() > 1) {
+            std::vector<segment> const& below = levels.back();
+            std::size_t s = 0;
+            auto above = detail::approximate<key_type>([&](key_type& key, std::size_t& pos) {
+                if (s == below.size())
+                    return false;
+                key = below[s].first;
+                pos = s++;
+                return true;
+            }, static_cast<double>(epsilon_levels));
+            levels.push_back(std::move(above));
+        }
+    }
+};
+}
+
+#endif // FLAGGEDT_INDEX_H
@@ -0,0 +1,730 @@
+/*
+    Copyright (c) 2016 Martin Buck
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//flags of numbers, arithmetic on bounded numbers and FlaggedArray
+
+#ifndef FLAGGEDT_NUMERIC_H
+#define FLAGGEDT_NUMERIC_H
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "flaggedT_base.h"
+
+FLAGGEDT_EXPORT namespace flaggedT {
+
+//------------------------------------------------------------------------------
+
+template <typename T>
+class NonZero : public FlaggedTBase<T> {
+    using base = FlaggedTBase<T>;
+
+protected:
+    ///for derived flags, which validate a stricter condition themselves
+    constexpr NonZero(detail::trusted_t, T&& in)
+        : base(std::forward<T>(in)) {}
+
+public:
+    NonZero() = delete;
+
+    NonZero(NonZero const&) = default;
+    NonZero(NonZero&&) = default;
+    NonZero& operator=(NonZero const&) = default;
+    NonZero& operator=(NonZero&&) = default;
+
+    ///THROWS
+    explicit constexpr NonZero(T&& in)
+        : base(std::forward<T>(in)) {
+
+        if (!is_valid(base::data))
+            detail::violated(FlaggedTError("Can't pass 0 to constructor of NonZero", FlagKind::NonZero, Violation::Zero, detail::as_number(base::data), 0), base::data, detail::clamp_above<T>{0});
+    }
+
+    static constexpr bool is_valid(T const& in) {
+        return 0 != in;
+    }
+
+    ///from every flag with a narrower interval (see detail::interval_of), without any check
+    template <FLAGGEDT_NARROWER(F, NonZero)>
+    constexpr NonZero(F in)
+        : base(std::move(in).unwrap()) {}
+};
+
+//------------------------------------------------------------------------------
+
+template <typename T>
+class Positive : public NonZero<T> {
+    using base = NonZero<T>;
+
+protected:
+    ///for derived flags, which validate a stricter condition themselves
+    constexpr Positive(detail::trusted_t, T&& in)
+        : base(detail::trusted_t{}, std::forward<T>(in)) {}
+
+public:
+    Positive() = delete;
+
+    Positive(Positive const&) = default;
+    Positive(Positive&&) = default;
+    Positive& operator=(Positive const&) = default;
+    Positive& operator=(Positive&&) = default;
+
+    ///THROWS
+    explicit constexpr Positive(T&& in)
+        : base(detail::trusted_t{}, std::forward<T>(in)) {
+
+        if (!is_valid(base::data))
+            detail::violated(FlaggedTError("Can't pass <= 0 to constructor of Positive", FlagKind::Positive, Violation::TooSmall, detail::as_number(base::data), 0), base::data, detail::clamp_above<T>{0});
+    }
+
+    static constexpr bool is_valid(T const& in) {
+        return in > 0;
+    }
+
+    ///from every flag with a narrower interval (see detail::interval_of), without any check
+    template <FLAGGEDT_NARROWER(F, Positive)>
+    constexpr Positive(F in)
+        : base(detail::trusted_t{}, std::move(in).unwrap()) {}
+};
+
+//------------------------------------------------------------------------------
+
+template <typename T>
+class PowerOfTwo : public Positive<T> {
+    static_assert(std::is_integral<T>::value, "PowerOfTwo requires an integral type");
+
+    using base = Positive<T>;
+
+public:
+    PowerOfTwo() = delete;
+
+    PowerOfTwo(PowerOfTwo const&) = default;
+    PowerOfTwo(PowerOfTwo&&) = default;
+    PowerOfTwo& operator=(PowerOfTwo const&) = default;
+    PowerOfTwo& operator=(PowerOfTwo&&) = default;
+
+    ///THROWS
+    explicit constexpr PowerOfTwo(T&& in)
+        : base(detail::trusted_t{}, std::forward<T>(in)) {
+
+        if (!is_valid(base::data))
+            detail::violated(FlaggedTError("Passed value to constructor of PowerOfTwo is not a power of two", FlagKind::PowerOfTwo, Violation::NotPowerOfTwo, detail::as_number(base::data), 0));
+    }
+
+    static constexpr bool is_valid(T const& in) {
+        return in > 0 && (in & (in - 1)) == 0;
+    }
+
+    ///exponent of the wrapped value (data == 1 << log2())
+    constexpr unsigned log2() const {
+        using U = typename std::make_unsigned<T>::type;
+        auto x = static_cast<U>(base::data);
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_ctzll(static_cast<unsigned long long>(x)));
+#else
+        unsigned n = 0;
+        while (x >>= 1)
+            ++n;
+        return n;
+#endif
+    }
+
+    ///x % data, computed as a mask (x must be non-negative)
+    template <typename U>
+    constexpr U mod(U x) const {
+        return x & static_cast<U>(base::data - 1);
+    }
+
+    ///x / data, computed as a shift (x must be non-negative)
+    template <typename U>
+    constexpr U div(U x) const {
+        return x >> log2();
+    }
+
+    ///x * data, computed as a shift (x must be non-negative)
+    template <typename U>
+    constexpr U mul(U x) const {
+        return x << log2();
+    }
+};
+
+//------------------------------------------------------------------------------
+
+template <typename T>
+class NonPositive : public FlaggedTBase<T> {
+    using base = FlaggedTBase<T>;
+
+public:
+    NonPositive() = delete;
+
+    NonPositive(NonPositive const&) = default;
+    NonPositive(NonPositive&&) = default;
+    NonPositive& operator=(NonPositive const&) = default;
+    NonPositive& operator=(NonPositive&&) = default;
+
+    ///THROWS
+    explicit constexpr NonPositive(T&& in)
+        : base(std::forward<T>(in)) {
+
+        if (!is_valid(base::data))
+            detail::violated(FlaggedTError("Can't pass > 0 to constructor of NonPositive", FlagKind::NonPositive, Violation::TooBig, detail::as_number(base::data), 0), base::data, detail::clamp_to<T>{0});
+    }
+
+    static constexpr bool is_valid(T const& in) {
+        return in <= 0;
+    }
+
+    ///from every flag with a narrower interval (see detail::interval_of), without any check
+    template <FLAGGEDT_NARROWER(F, NonPositive)>
+    constexpr NonPositive(F in)
+        : base(std::move(in).unwrap()) {}
+};
+
+//------------------------------------------------------------------------------
+
+template <typename T>
+class Negative : public NonZero<T> {
+    using base = NonZero<T>;
+
+public:
+    Negative() = delete;
+
+    Negative(Negative const&) = default;
+    Negative(Negative&&) = default;
+    Negative& operator=(Negative const&) = default;
+    Negative& operator=(Negative&&) = default;
+
+    ///THROWS
+    explicit constexpr Negative(T&& in)
+        : base(detail::trusted_t{}, std::forward<T>(in)) {
+
+        if (!is_valid(base::data))
+            detail::violated(FlaggedTError("Can't pass >= 0 to constructor of Negative", FlagKind::Negative, Violation::TooBig, detail::as_number(base::data), 0), base::data, detail::clamp_below<T>{0});
+    }
+
+    static constexpr bool is_valid(T const& in) {
+        return in < 0;
+    }
+
+    ///from every flag with a narrower interval (see detail::interval_of), without any check
+    template <FLAGGEDT_NARROWER(F, Negative)>
+    constexpr Negative(F in)
+        : base(detail::trusted_t{}, std::move(in).unwrap()) {}
+};
+
+template <typename T>
+class NonNegative : public FlaggedTBase<T> {
+    using base = FlaggedTBase<T>;
+
+public:
+    NonNegative() = delete;
+
+    NonNegative(NonNegative const&) = default;
+    NonNegative(NonNegative&&) = default;
+    NonNegative& operator=(NonNegative const&) = default;
+    NonNegative& operator=(NonNegative&&) = default;
+
+    ///THROWS
+    explicit constexpr NonNegative(T&& in)
+        : base(std::forward<T>(in)) {
+
+        if (!is_valid(base::data))
+            detail::violated(FlaggedTError("Can't pass < 0 to constructor of NonNegative", FlagKind::NonNegative, Violation::TooSmall, detail::as_number(base::data), 0), base::data, detail::clamp_to<T>{0});
+    }
+
+    static constexpr bool is_valid(T const& in) {
+        return in >= 0;
+    }
+
+    ///from every flag with a narrower interval (see detail::interval_of), without any check
+    template <FLAGGEDT_NARROWER(F, NonNegative)>
+    constexpr NonNegative(F in)
+        : base(std::move(in).unwrap()) {}
+};
+
+//------------------------------------------------------------------------------
+
+template <typename T, int64_t MAX>
+class CeiledInclusive : public FlaggedTBase<T> {
+    using base = FlaggedTBase<T>;
+
+public:
+    CeiledInclusive() = delete;
+
+    CeiledInclusive(CeiledInclusive const&) = default;
+    CeiledInclusive(CeiledInclusive&&) = default;
+    CeiledInclusive& operator=(CeiledInclusive const&) = default;
+    CeiledInclusive& operator=(CeiledInclusive&&) = default;
+
+    ///THROWS
+    explicit constexpr CeiledInclusive(T&& in)
+        : base(std::forward<T>(in)) {
+
+        if (!is_valid(base::data))
+            detail::violated(FlaggedTError("Passed value to constructor of CeiledInclusive is too big", FlagKind::CeiledInclusive, Violation::TooBig, detail::as_number(base::data), MAX), base::data, detail::clamp_to<T>{MAX});
+    }
+
+    static constexpr bool is_valid(T const& in) {
+        return in <= MAX;
+    }
+
+    ///from every flag with a narrower interval (see detail::interval_of), without any check
+    template <FLAGGEDT_NARROWER(F, CeiledInclusive)>
+    constexpr CeiledInclusive(F in)
+        : base(std::move(in).unwrap()) {}
+};
+
+template <typename T, int64_t MAX>
+class CeiledExclusive : public FlaggedTBase<T> {
+    using base = FlaggedTBase<T>;
+
+public:
+    CeiledExclusive() = delete;
+
+    CeiledExclusive(CeiledExclusive const&) = default;
+    CeiledExclusive(CeiledExclusive&&) = default;
+    CeiledExclusive& operator=(CeiledExclusive const&) = default;
+    CeiledExclusive& operator=(CeiledExclusive&&) = default;
+
+    ///THROWS
+    explicit constexpr CeiledExclusive(T&& in)
+        : base(std::forward<T>(in)) {
+
+        if (!is_valid(base::data))
+            detail::violated(FlaggedTError("Passed value to constructor of CeiledExclusive is too big", FlagKind::CeiledExclusive, Violation::TooBig, detail::as_number(base::data), MAX), base::data, detail::clamp_below<T>{MAX});
+    }
+
+    static constexpr bool is_valid(T const& in) {
+        return in < MAX;
+    }
+
+    ///from every flag with a narrower interval (see detail::interval_of), without any check
+    template <FLAGGEDT_NARROWER(F, CeiledExclusive)>
+    constexpr CeiledExclusive(F in)
+        : base(std::move(in).unwrap()) {}
+};
+
+//------------------------------------------------------------------------------
+
+template <typename T, int64_t MIN>
+class FlooredInclusive : public FlaggedTBase<T> {
+    using base = FlaggedTBase<T>;
+
+public:
+    FlooredInclusive() = delete;
+
+    FlooredInclusive(FlooredInclusive const&) = default;
+    FlooredInclusive(FlooredInclusive&&) = default;
+    FlooredInclusive& operator=(FlooredInclusive const&) = default;
+    FlooredInclusive& operator=(FlooredInclusive&&) = default;
+
+    ///THROWS
+    explicit constexpr FlooredInclusive(T&& in)
+        : base(std::forward<T>(in)) {
+
+        if (!is_valid(base::data))
+            detail::violated(FlaggedTError("Passed value to constructor of FlooredInclusive is too small", FlagKind::FlooredInclusive, Violation::TooSmall, detail::as_number(base::data), MIN), base::data, detail::clamp_to<T>{MIN});
+    }
+
+    static constexpr bool is_valid(T const& in) {
+        return in >= MIN;
+    }
+
+    ///from every flag with a narrower interval (see detail::interval_of), without any check
+    template <FLAGGEDT_NARROWER(F, FlooredInclusive)>
+    constexpr FlooredInclusive(F in)
+        : base(std::move(in).unwrap()) {}
+};
+
+template <typename T, int64_t MIN>
+class FlooredExclusive : public FlaggedTBase<T> {
+    using base = FlaggedTBase<T>;
+
+public:
+    FlooredExclusive() = delete;
+
+    FlooredExclusive(FlooredExclusive const&) = default;
+    FlooredExclusive(FlooredExclusive&&) = default;
+    FlooredExclusive& operator=(FlooredExclusive const&) = default;
+    FlooredExclusive& operator=(FlooredExclusive&&) = default;
+
+    ///THROWS
+    explicit constexpr FlooredExclusive(T&& in)
+        : base(std::forward<T>(in)) {
+
+        if (!is_valid(base::data))
+            detail::violated(FlaggedTError("Passed value to constructor of FlooredExclusive is too small", FlagKind::FlooredExclusive, Violation::TooSmall, detail::as_number(base::data), MIN), base::data, detail::clamp_above<T>{MIN});
+    }
+
+    static constexpr bool is_valid(T const& in) {
+        return in > MIN;
+    }
+
+    ///from every flag with a narrower interval (see detail::interval_of), without any check
+    template <FLAGGEDT_NARROWER(F, FlooredExclusive)>
+    constexpr FlooredExclusive(F in)
+        : base(std::move(in).unwrap()) {}
+};
+
+//------------------------------------------------------------------------------
+
+template <typename T, int64_t MIN, int64_t MAX>
+class BoundedInclusive : public FlaggedTBase<T> {
+    static_assert(MIN <= MAX, "MIN not <= MAX");
+
+    using base = FlaggedTBase<T>;
+
+    friend struct detail::access;
+
+    constexpr BoundedInclusive(detail::trusted_t, T&& in)
+        : base(std::forward<T>(in)) {}
+
+public:
+    BoundedInclusive() = delete;
+
+    BoundedInclusive(BoundedInclusive const&) = default;
+    BoundedInclusive(BoundedInclusive&&) = default;
+    BoundedInclusive& operator=(BoundedInclusive const&) = default;
+    BoundedInclusive& operator=(BoundedInclusive&&) = default;
+
+    ///THROWS
+    explicit constexpr BoundedInclusive(T&& in)
+        : base(std::forward<T>(in)) {
+
+        if (!is_valid(base::data)) {
+            if (base::data > MAX)
+                detail::violated(FlaggedTError("Passed value to constructor of BoundedInclusive is too big", FlagKind::BoundedInclusive, Violation::TooBig, detail::as_number(base::data), MAX), base::data, detail::clamp_to<T>{MAX});
+            else
+                detail::violated(FlaggedTError("Passed value to constructor of BoundedInclusive is too small", FlagKind::BoundedInclusive, Violation::TooSmall, detail::as_number(base::data), MIN), base::data, detail::clamp_to<T>{MIN});
+        }
+    }
+
+    static constexpr bool is_valid(T const& in) {
+        return (in >= MIN) & (in <= MAX); //no short circuit, keeps checks of whole buffers branch free
+    }
+
+    ///from every flag with a narrower interval (see detail::interval_of), without any check
+    template <FLAGGEDT_NARROWER(F, BoundedInclusive)>
+    constexpr BoundedInclusive(F in)
+        : base(std::move(in).unwrap()) {}
+};
+
+template <typename T, int64_t MIN, int64_t MAX>
+class BoundedExclusive : public FlaggedTBase<T> {
+    static_assert(MIN < MAX, "MIN not < MAX");
+
+    using base = FlaggedTBase<T>;
+
+    friend struct detail::access;
+
+    constexpr BoundedExclusive(detail::trusted_t, T&& in)
+        : base(std::forward<T>(in)) {}
+
+public:
+    BoundedExclusive() = delete;
+
+    BoundedExclusive(BoundedExclusive const&) = default;
+    BoundedExclusive(BoundedExclusive&&) = default;
+    BoundedExclusive& operator=(BoundedExclusive const&) = default;
+    BoundedExclusive& operator=(BoundedExclusive&&) = default;
+
+    ///THROWS
+    explicit constexpr BoundedExclusive(T&& in)
+        : base(std::forward<T>(in)) {
+
+        if (!is_valid(base::data)) {
+            if (base::data >= MAX)
+                detail::violated(FlaggedTError("Passed value to constructor of BoundedExclusive is too big", FlagKind::BoundedExclusive, Violation::TooBig, detail::as_number(base::data), MAX), base::data, detail::clamp_below<T>{MAX});
+            else
+                detail::violated(FlaggedTError("Passed value to constructor of BoundedExclusive is too small", FlagKind::BoundedExclusive, Violation::TooSmall, detail::as_number(base::data), MIN), base::data, detail::clamp_above<T>{MIN});
+        }
+    }
+
+    static constexpr bool is_valid(T const& in) {
+        return (in > MIN) & (in < MAX); //no short circuit, keeps checks of whole buffers branch free
+    }
+
+    ///from every flag with a narrower interval (see detail::interval_of), without any check
+    template <FLAGGEDT_NARROWER(F, BoundedExclusive)>
+    constexpr BoundedExclusive(F in)
+        : base(std::move(in).unwrap()) {}
+};
+
+//------------------------------------------------------------------------------
+
+namespace detail {
+
+constexpr int64_t min4(int64_t a, int64_t b, int64_t c, int64_t d) {
+    return std::min(std::min(a, b), std::min(c, d));
+}
+
+constexpr int64_t max4(int64_t a, int64_t b, int64_t c, int64_t d) {
+    return std::max(std::max(a, b), std::max(c, d));
+}
+
+///whether every value within [LO, HI] is representable by T
+template <typename T>
+constexpr bool interval_fits(int64_t lo, int64_t hi) {
+    return std::is_floating_point<T>::value
+        || ((std::is_signed<T>::value
+                ? lo >= static_cast<int64_t>(std::numeric_limits<T>::min())
+                : lo >= 0)
+            && (hi <= 0
+                || static_cast<uint64_t>(hi) <= static_cast<uint64_t>(std::numeric_limits<T>::max())));
+}
+
+template <typename T>
+constexpr bool checked_add(T a, T b, T& result) {
+#if defined(__GNUC__) || defined(__clang__)
+    return !__builtin_add_overflow(a, b, &result);
+#else
+    if ((b > 0 && a > std::numeric_limits<T>::max() - b) || (b < 0 && a < std::numeric_limits<T>::min() - b))
+        return false;
+    result = a + b;
+    return true;
+#endif
+}
+
+template <typename T>
+constexpr bool checked_sub(T a, T b, T& result) {
+#if defined(__GNUC__) || defined(__clang__)
+    return !__builtin_sub_overflow(a, b, &result);
+#else
+    if ((b < 0 && a > std::numeric_limits<T>::max() + b) || (b > 0 && a < std::numeric_limits<T>::min() + b))
+        return false;
+    result = a - b;
+    return true;
+#endif
+}
+
+template <typename T>
+constexpr bool checked_mul(T a, T b, T& result) {
+#if defined(__GNUC__) || defined(__clang__)
+    return !__builtin_mul_overflow(a, b, &result);
+#else
+    if (a != 0 && b != 0) {
+        const T r = static_cast<T>(a * b);
+        if (r / b != a)
+            return false;
+    }
+    result = static_cast<T>(a * b);
+    return true;
+#endif
+}
+
+template <typename R>
+struct kind_of;
+
+template <typename T, int64_t MIN, int64_t MAX>
+struct kind_of<BoundedInclusive<T, MIN, MAX>> : std::integral_constant<FlagKind, FlagKind::BoundedInclusive> {};
+
+template <typename T, int64_t MIN, int64_t MAX>
+struct kind_of<BoundedExclusive<T, MIN, MAX>> : std::integral_constant<FlagKind, FlagKind::BoundedExclusive> {};
+
+///result of a binary operation on two bounded types
+///the result interval is known at compile time, only if it doesn't fit T the operation itself is checked for overflow
+template <typename R, typename T, typename Op, typename CheckedOp>
+constexpr R bounded_op(T const& a, T const& b, Op op, CheckedOp checked, std::true_type /*fits*/) {
+    (void)checked;
+    return access::make_trusted<R>(static_cast<T>(op(a, b)));
+}
+
+///THROWS
+template <typename R, typename T, typename Op, typename CheckedOp>
+constexpr R bounded_op(T const& a, T const& b, Op op, CheckedOp checked, std::false_type /*fits*/) {
+    (void)op;
+    T result{};
+    if (!checked(a, b, result))
+        detail::violated(FlaggedTError("Result of bounded arithmetic overflows the wrapped type", kind_of<R>::value, Violation::Overflow));
+    return access::make_trusted<R>(std::move(result));
+}
+
+template <typename R, typename T, int64_t LO, int64_t HI, typename Op, typename CheckedOp>
+constexpr R bounded_op(T const& a, T const& b, Op op, CheckedOp checked) {
+    return bounded_op<R>(a, b, op, checked, std::integral_constant<bool, interval_fits<T>(LO, HI)>{});
+}
+
+///floating point results are rounded, which can reach an open bound (e.g. a product of tiny values underflowing to 0)
+///so they are validated by the constructor of R, just like any other value passed to it. THROWS
+template <typename R, typename T, int64_t LO, int64_t HI, typename Op, typename CheckedOp>
+constexpr R bounded_op_exclusive(T const& a, T const& b, Op op, CheckedOp checked, std::true_type /*floating point*/) {
+    (void)checked;
+    return R(static_cast<T>(op(a, b)));
+}
+
+template <typename R, typename T, int64_t LO, int64_t HI, typename Op, typename CheckedOp>
+constexpr R bounded_op_exclusive(T const& a, T const& b, Op op, CheckedOp checked, std::false_type /*floating point*/) {
+    return bounded_op<R, T, LO, HI>(a, b, op, checked);
+}
+
+template <typename R, typename T, int64_t LO, int64_t HI, typename Op, typename CheckedOp>
+constexpr R bounded_op_exclusive(T const& a, T const& b, Op op, CheckedOp checked) {
+    return bounded_op_exclusive<R, T, LO, HI>(a, b, op, checked, std::is_floating_point<T>{});
+}
+
+}
+
+//------------------------------------------------------------------------------
+
+///THROWS only if the resulting interval can't be represented by T
+template <typename T, int64_t AMIN, int64_t AMAX, int64_t BMIN, int64_t BMAX>
+constexpr BoundedInclusive<T, AMIN + BMIN, AMAX + BMAX> operator+(BoundedInclusive<T, AMIN, AMAX> const& a, BoundedInclusive<T, BMIN, BMAX> const& b) {
+    return detail::bounded_op<BoundedInclusive<T, AMIN + BMIN, AMAX + BMAX>, T, AMIN + BMIN, AMAX + BMAX>(
+        a.get(), b.get(), [](T x, T y) { return x + y; }, [](auto x, auto y, auto& r) { return detail::checked_add(x, y, r); });
+}
+
+///THROWS only if the resulting interval can't be represented by T
+template <typename T, int64_t AMIN, int64_t AMAX, int64_t BMIN, int64_t BMAX>
+constexpr BoundedInclusive<T, AMIN - BMAX, AMAX - BMIN> operator-(BoundedInclusive<T, AMIN, AMAX> const& a, BoundedInclusive<T, BMIN, BMAX> const& b) {
+    return detail::bounded_op<BoundedInclusive<T, AMIN - BMAX, AMAX - BMIN>, T, AMIN - BMAX, AMAX - BMIN>(
+        a.get(), b.get(), [](T x, T y) { return x - y; }, [](auto x, auto y, auto& r) { return detail::checked_sub(x, y, r); });
+}
+
+///THROWS only if the resulting interval can't be represented by T
+template <typename T, int64_t AMIN, int64_t AMAX, int64_t BMIN, int64_t BMAX,
+          int64_t RMIN = detail::min4(AMIN * BMIN, AMIN * BMAX, AMAX * BMIN, AMAX * BMAX),
+          int64_t RMAX = detail::max4(AMIN * BMIN, AMIN * BMAX, AMAX * BMIN, AMAX * BMAX)>
+constexpr BoundedInclusive<T, RMIN, RMAX> operator*(BoundedInclusive<T, AMIN, AMAX> const& a, BoundedInclusive<T, BMIN, BMAX> const& b) {
+    return detail::bounded_op<BoundedInclusive<T, RMIN, RMAX>, T, RMIN, RMAX>(
+        a.get(), b.get(), [](T x, T y) { return x * y; }, [](auto x, auto y, auto& r) { return detail::checked_mul(x, y, r); });
+}
+
+///THROWS only if the resulting interval can't be represented by T
+template <typename T, int64_t AMIN, int64_t AMAX>
+constexpr BoundedInclusive<T, -AMAX, -AMIN> operator-(BoundedInclusive<T, AMIN, AMAX> const& a) {
+    return detail::bounded_op<BoundedInclusive<T, -AMAX, -AMIN>, T, -AMAX, -AMIN>(
+        T(0), a.get(), [](T x, T y) { return x - y; }, [](auto x, auto y, auto& r) { return detail::checked_sub(x, y, r); });
+}
+
+///THROWS only if the resulting interval can't be represented by T, or (floating point T) the rounded result reaches an open bound
+template <typename T, int64_t AMIN, int64_t AMAX, int64_t BMIN, int64_t BMAX>
+constexpr BoundedExclusive<T, AMIN + BMIN, AMAX + BMAX> operator+(BoundedExclusive<T, AMIN, AMAX> const& a, BoundedExclusive<T, BMIN, BMAX> const& b) {
+    return detail::bounded_op_exclusive<BoundedExclusive<T, AMIN + BMIN, AMAX + BMAX>, T, AMIN + BMIN, AMAX + BMAX>(
+        a.get(), b.get(), [](T x, T y) { return x + y; }, [](auto x, auto y, auto& r) { return detail::checked_add(x, y, r); });
+}
+
+///THROWS only if the resulting interval can't be represented by T, or (floating point T) the rounded result reaches an open bound
+template <typename T, int64_t AMIN, int64_t AMAX, int64_t BMIN, int64_t BMAX>
+constexpr BoundedExclusive<T, AMIN - BMAX, AMAX - BMIN> operator-(BoundedExclusive<T, AMIN, AMAX> const& a, BoundedExclusive<T, BMIN, BMAX> const& b) {
+    return detail::bounded_op_exclusive<BoundedExclusive<T, AMIN - BMAX, AMAX - BMIN>, T, AMIN - BMAX, AMAX - BMIN>(
+        a.get(), b.get(), [](T x, T y) { return x - y; }, [](auto x, auto y, auto& r) { return detail::checked_sub(x, y, r); });
+}
+
+///THROWS only if the resulting interval can't be represented by T, or (floating point T) the rounded result reaches an open bound
+template <typename T, int64_t AMIN, int64_t AMAX, int64_t BMIN, int64_t BMAX,
+          int64_t RMIN = detail::min4(AMIN * BMIN, AMIN * BMAX, AMAX * BMIN, AMAX * BMAX),
+          int64_t RMAX = detail::max4(AMIN * BMIN, AMIN * BMAX, AMAX * BMIN, AMAX * BMAX)>
+constexpr BoundedExclusive<T, RMIN, RMAX> operator*(BoundedExclusive<T, AMIN, AMAX> const& a, BoundedExclusive<T, BMIN, BMAX> const& b) {
+    return detail::bounded_op_exclusive<BoundedExclusive<T, RMIN, RMAX>, T, RMIN, RMAX>(
+        a.get(), b.get(), [](T x, T y) { return x * y; }, [](auto x, auto y, auto& r) { return detail::checked_mul(x, y, r); });
+}
+
+///THROWS only if the resulting interval can't be represented by T, or (floating point T) the rounded result reaches an open bound
+template <typename T, int64_t AMIN, int64_t AMAX>
+constexpr BoundedExclusive<T, -AMAX, -AMIN> operator-(BoundedExclusive<T, AMIN, AMAX> const& a) {
+    return detail::bounded_op_exclusive<BoundedExclusive<T, -AMAX, -AMIN>, T, -AMAX, -AMIN>(
+        T(0), a.get(), [](T x, T y) { return x - y; }, [](auto x, auto y, auto& r) { return detail::checked_sub(x, y, r); });
+}
+
+//------------------------------------------------------------------------------
+
+///contiguous buffer of a numeric flag's inner type, validated as a whole
+///the buffer is checked in a single branch free pass and then viewed as elements of Flag, without copying
+template <typename Flag>
+class FlaggedArray : public FlaggedTBase<std::vector<typename Flag::wrapped_type>> {
+    using T = typename Flag::wrapped_type;
+    using base = FlaggedTBase<std::vector<T>>;
+
+    static_assert(sizeof(Flag) == sizeof(T) && alignof(Flag) == alignof(T), "FlaggedArray requires Flag to have the layout of its inner type");
+    static_assert(std::is_trivially_copyable<Flag>::value && std::is_standard_layout<Flag>::value, "FlaggedArray requires a trivially copyable, standard layout Flag");
+
+    friend struct detail::access;
+
+    ///for buffers valid by construction, e.g. loaded from a file which records the flag
+    FlaggedArray(detail::trusted_t, std::vector<T>&& in)
+        : base(std::move(in)) {}
+
+public:
+    FlaggedArray() = delete;
+
+    FlaggedArray(FlaggedArray const&) = default;
+    FlaggedArray(FlaggedArray&&) = default;
+    FlaggedArray& operator=(FlaggedArray const&) = default;
+    FlaggedArray& operator=(FlaggedArray&&) = default;
+
+    ///THROWS
+    explicit FlaggedArray(std::vector<T>&& in)
+        : base(std::move(in)) {
+
+        if (detail::checks_enabled() && !all_valid(base::data.data(), base::data.size()))
+            fix_invalid();
+    }
+
+    FlaggedArray(std::vector<Flag> const& in)
+        : base(std::vector<T>(reinterpret_cast<T const*>(in.data()), reinterpret_cast<T const*>(in.data()) + in.size())) {}
+
+    ///whether all n elements starting at first are valid for Flag
+    static bool all_valid(T const* first, std::size_t n) {
+        //no early exit within a block and an accumulator of T's width, so the inner loop vectorizes
+        using mask_t = typename std::conditional<sizeof(T) == 8, uint64_t,
+                       typename std::conditional<sizeof(T) == 4, uint32_t,
+                       typename std::conditional<sizeof(T) == 2, uint16_t, uint8_t>::type>::type>::type;
+        constexpr std::size_t block = 1024;
+
+        for (std::size_t i = 0; i < n; i += block) {
+            const std::size_t end = std::min(n, i + block);
+            mask_t invalid = 0;
+            for (std::size_t j = i; j < end; ++j)
+                invalid |= static_cast<mask_t>(!Flag::is_valid(first[j]));
+            if (invalid)
+                return false;
+        }
+        return true;
+    }
+
+    std::size_t size() const {
+        return base::data.size();
+    }
+
+    bool empty() const {
+        return base::data.empty();
+    }
+
+    Flag const* begin() const {
+        return reinterpret_cast<Flag const*>(base::data.data());
+    }
+
+    Flag const* end() const {
+        return begin() + size();
+    }
+
+    Flag const& operator[](std::size_t i) const {
+        return begin()[i];
+    }
+
+private:
+    ///reacts to each invalid element just like constructing Flag from it does (throwing, aborting or clamping)
+    void fix_invalid() {
+        for (auto& x : base::data)
+            if (!Flag::is_valid(x))
+                x = Flag(T(x)).get();
+    }
+};
+
+}
+
+#endif // FLAGGEDT_NUMERIC_H
@@ -0,0 +1,756 @@
+/*
+    Copyright (c) 2016 Martin Buck
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//Sorted, Shuffled, Unique and UniqueAndSorted
+
+#ifndef FLAGGEDT_ORDERING_H
+#define FLAGGEDT_ORDERING_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "flaggedT_base.h"
+
+#ifdef FLAGGEDT_PARALLEL
+    #include <thread>
+
+    #ifndef FLAGGEDT_PARALLEL_THREADS
+        #define FLAGGEDT_PARALLEL_THREADS std::thread::hardware_concurrency()
+    #endif
+    #ifndef FLAGGEDT_PARALLEL_MIN_SIZE
+        #define FLAGGEDT_PARALLEL_MIN_SIZE (std::size_t(1) << 20)
+    #endif
+#endif
+
+FLAGGEDT_EXPORT namespace flaggedT {
+
+//------------------------------------------------------------------------------
+
+namespace detail {
+
+template <typename T>
+using element_t = typename std::iterator_traits<decltype(std::begin(std::declval<T&>()))>::value_type;
+
+template <typename Projection, typename E>
+using projected_t = decltype(std::declval<Projection const&>()(std::declval<E const&>()));
+
+///orders elements by Compare on their keys
+template <typename Compare, typename Projection>
+struct projected_less {
+    template <typename A, typename B>
+    constexpr bool operator()(A const& a, B const& b) const {
+        return Compare{}(Projection{}(a), Projection{}(b));
+    }
+};
+
+///keys returned by reference (e.g. members or the elements themselves) are compared in place
+template <typename Compare, typename Projection, typename T>
+void comparison_sort_by(T& data, std::true_type /*key is a reference*/) {
+    std::sort(std::begin(data), std::end(data), projected_less<Compare, Projection>{});
+}
+
+///keys computed by value are computed once per element and sorted contiguously, the data is then permuted accordingly (Schwartzian transform)
+template <typename Compare, typename Projection, typename T>
+void comparison_sort_by(T& data, std::false_type /*key is a reference*/) {
+    using key = typename std::decay<projected_t<Projection, element_t<T>>>::type;
+
+    auto first = std::begin(data);
+    const auto n = static_cast<std::size_t>(std::distance(first, std::end(data)));
+
+    std::vector<std::pair<key, std::size_t>> keys;
+    keys.reserve(n);
+    for (std::size_t i = 0; i < n; ++i)
+        keys.emplace_back(Projection{}(first[i]), i);
+
+    std::sort(keys.begin(), keys.end(), [](std::pair<key, std::size_t> const& a, std::pair<key, std::size_t> const& b) {
+        return Compare{}(a.first, b.first);
+    });
+
+    //order[i] is the current position of the element belonging to i, the cycles of this permutation are moved in place
+    std::vector<std::size_t> order(n);
+    for (std::size_t i = 0; i < n; ++i)
+        order[i] = keys[i].second;
+    keys = {};
+
+    for (std::size_t i = 0; i < n; ++i) {
+        if (order[i] == i)
+            continue;
+
+        auto tmp = std::move(first[i]);
+        std::size_t j = i;
+        while (order[j] != i) {
+            const std::size_t k = order[j];
+            first[j] = std::move(first[k]);
+            order[j] = j;
+            j = k;
+        }
+        first[j] = std::move(tmp);
+        order[j] = j;
+    }
+}
+
+///compile time range [lo, hi] of the values of E, known for integers of up to 16 bits and integral flags bounded on both sides
+template <typename E, typename = void>
+struct value_range {
+    static constexpr bool known = false;
+};
+
+template <typename E>
+struct value_range<E, typename std::enable_if<std::is_integral<E>::value && !std::is_same<E, bool>::value && sizeof(E) <= 2>::type> {
+    static constexpr bool known = true;
+    static constexpr int64_t lo = std::numeric_limits<E>::min();
+    static constexpr int64_t hi = std::numeric_limits<E>::max();
+};
+
+template <typename E>
+struct value_range<E, typename std::enable_if<interval_of<E>::known && interval_of<E>::has_lo && interval_of<E>::has_hi && std::is_integral<typename interval_of<E>::wrapped_type>::value>::type> {
+    static constexpr bool known = true;
+    static constexpr int64_t lo = interval_of<E>::lo;
+    static constexpr int64_t hi = interval_of<E>::hi;
+};
+
+///1 if Compare orders ascending, -1 if descending, 0 if unknown
+template <typename Compare>
+struct counting_direction : std::integral_constant<int, 0> {};
+
+template <typename U>
+struct counting_direction<std::less<U>> : std::integral_constant<int, 1> {};
+
+template <typename U>
+struct counting_direction<std::greater<U>> : std::integral_constant<int, -1> {};
+
+///ranges of at most this many values are sorted by counting
+constexpr int64_t counting_sort_range() {
+    return int64_t(1) << 16;
+}
+
+template <typename Compare, typename Projection, typename E, bool KNOWN = value_range<E>::known>
+struct counting_sortable : std::false_type {};
+
+template <typename Compare, typename Projection, typename E>
+struct counting_sortable<Compare, Projection, E, true> : std::integral_constant<bool,
+    std::is_same<Projection, identity>::value
+    && counting_direction<Compare>::value != 0
+    && value_range<E>::hi - value_range<E>::lo < counting_sort_range()> {};
+
+template <typename E>
+E from_value(int64_t v, std::true_type /*integral*/) {
+    return static_cast<E>(v);
+}
+
+///flags bounded on both sides are constructed without a check, v lies within their interval
+template <typename E>
+E from_value(int64_t v, std::false_type /*integral*/) {
+    return access::make_trusted<E>(static_cast<typename interval_of<E>::wrapped_type>(v));
+}
+
+///counts each value of the range, then writes them in order, O(n + range)
+///with unique each value which occurred is written once, the end of the written values is returned for the caller to erase the rest
+template <typename Compare, typename T>
+auto counting_sort(T& data, bool unique = false) {
+    using E = element_t<T>;
+    using range = value_range<E>;
+    constexpr std::size_t size = static_cast<std::size_t>(range::hi - range::lo) + 1;
+
+    std::vector<std::size_t> counts(size, 0);
+    for (auto const& x : data)
+        ++counts[static_cast<std::size_t>(static_cast<int64_t>(x) - range::lo)];
+
+    auto out = std::begin(data);
+    for (std::size_t k = 0; k < size; ++k) {
+        const std::size_t v = counting_direction<Compare>::value > 0 ? k : size - 1 - k;
+        out = std::fill_n(out, unique ? std::min<std::size_t>(counts[v], 1) : counts[v], from_value<E>(range::lo + static_cast<int64_t>(v), std::is_integral<E>{}));
+    }
+    return out;
+}
+
+template <typename Compare, typename Projection, typename T>
+void sort_by(T& data, std::false_type /*counting sortable*/) {
+    comparison_sort_by<Compare, Projection>(data, std::is_reference<projected_t<Projection, element_t<T>>>{});
+}
+
+///counting sort unless there are far fewer elements than possible values
+template <typename Compare, typename Projection, typename T>
+void sort_by(T& data, std::true_type /*counting sortable*/) {
+    using range = value_range<element_t<T>>;
+    const auto n = static_cast<int64_t>(std::distance(std::begin(data), std::end(data)));
+    if (n < (range::hi - range::lo) / 8)
+        comparison_sort_by<Compare, Projection>(data, std::true_type{});
+    else
+        counting_sort<Compare>(data);
+}
+
+///sorts by counting if the elements have a small compile time range (see value_range) and are compared directly, by comparison otherwise
+template <typename Compare, typename Projection, typename T>
+void sort_by(T& data) {
+    sort_by<Compare, Projection>(data, counting_sortable<Compare, Projection, element_t<T>>{});
+}
+
+///moves the elements of the sorted range [first, last) whose keys aren't equivalent to the previous one to its front, returns their end
+template <typename Compare, typename Projection, typename It>
+It unique_compact(It first, It last, std::false_type /*trivially copyable*/) {
+    using E = typename std::iterator_traits<It>::value_type;
+    return std::unique(first, last, [](E const& kept, E const& next) {
+        return !Compare{}(Projection{}(kept), Projection{}(next));
+    });
+}
+
+///cheap copies are written unconditionally and kept by advancing the end, so duplicates cause no mispredicted branches
+///sorted data has equivalent keys next to each other, so each element is compared to its original predecessor instead of the last kept one
+template <typename Compare, typename Projection, typename It>
+It unique_compact(It first, It last, std::true_type /*trivially copyable*/) {
+    const auto n = static_cast<std::size_t>(std::distance(first, last));
+    if (n == 0)
+        return last;
+
+    auto previous = first[0];
+    std::size_t kept = 1;
+    for (std::size_t i = 1; i < n; ++i) {
+        const auto next = first[i];
+        const bool isNew = Compare{}(Projection{}(previous), Projection{}(next));
+        first[kept] = next;
+        kept += static_cast<std::size_t>(isNew);
+        previous = next;
+    }
+    return first + static_cast<std::ptrdiff_t>(kept);
+}
+
+template <typename Compare, typename Projection, typename It>
+It unique_compact(It first, It last) {
+    using E = typename std::iterator_traits<It>::value_type;
+    return unique_compact<Compare, Projection>(first, last, std::is_trivially_copyable<E>{});
+}
+
+#ifdef FLAGGEDT_PARALLEL
+///threads which are joined when leaving the scope, also if starting a later one throws (destroying a joinable std::thread terminates)
+class joined_threads {
+    std::vector<std::thread> threads;
+
+public:
+    joined_threads() = default;
+
+    joined_threads(joined_threads const&) = delete;
+    joined_threads& operator=(joined_threads const&) = delete;
+
+    ~joined_threads() {
+        join();
+    }
+
+    template <typename F>
+    void start(F&& f) {
+        threads.emplace_back(std::forward<F>(f));
+    }
+
+    void join() {
+        for (auto& thread : threads)
+            if (thread.joinable())
+                thread.join();
+    }
+};
+
+///compacts chunks of [first, last) on separate threads, then moves them together while dropping duplicates across chunk boundaries
+template <typename Compare, typename Projection, typename It>
+It unique_compact_parallel(It first, It last, std::size_t threads) {
+    const auto n = static_cast<std::size_t>(std::distance(first, last));
+    threads = std::min(threads, n);
+    std::vector<It> begins(threads), ends(threads);
+    {
+        joined_threads workers;
+        for (std::size_t t = 0; t < threads; ++t) {
+            begins[t] = first + static_cast<std::ptrdiff_t>(n * t / threads);
+            auto chunkEnd = first + static_cast<std::ptrdiff_t>(n * (t + 1) / threads);
+            workers.start([&ends, &begins, chunkEnd, t] {
+                ends[t] = unique_compact<Compare, Projection>(begins[t], chunkEnd);
+            });
+        }
+    }
+
+    //each chunk is unique, only its first element can be equivalent to the last one kept before it
+    auto out = ends[0];
+    for (std::size_t t = 1; t < threads; ++t) {
+        auto in = begins[t];
+        if (in != ends[t] && !Compare{}(Projection{}(*std::prev(out)), Projection{}(*in)))
+            ++in;
+        out = in == out ? ends[t] : std::move(in, ends[t], out);
+    }
+    return out;
+}
+#endif
+
+///removes elements with keys equivalent to the previous one, data has to be sorted by Compare and Projection already
+///with FLAGGEDT_PARALLEL large data is compacted in chunks on FLAGGEDT_PARALLEL_THREADS threads
+template <typename Compare, typename Projection, typename T>
+void unique_by(T& data) {
+    if (std::begin(data) == std::end(data))
+        return;
+#ifdef FLAGGEDT_PARALLEL
+    const auto n = static_cast<std::size_t>(std::distance(std::begin(data), std::end(data)));
+    const auto threads = static_cast<std::size_t>(FLAGGEDT_PARALLEL_THREADS);
+    if (threads > 1 && n >= FLAGGEDT_PARALLEL_MIN_SIZE) {
+        data.erase(unique_compact_parallel<Compare, Projection>(std::begin(data), std::end(data), threads), std::end(data));
+        return;
+    }
+#endif
+    data.erase(unique_compact<Compare, Projection>(std::begin(data), std::end(data)), std::end(data));
+}
+
+///keys which are equivalent under Compare exactly if they are equal, so duplicates can be found by hashing: integers ordered by std::less or std::greater
+template <typename Compare, typename Projection, typename E, typename K = typename std::decay<projected_t<Projection, E>>::type>
+struct hash_dedupable : std::integral_constant<bool,
+    std::is_integral<K>::value
+    && sizeof(K) <= sizeof(uint64_t)
+    && counting_direction<Compare>::value != 0> {};
+
+///smaller data is sorted without looking for duplicates first
+constexpr std::size_t hash_dedup_min_size() {
+    return 1024;
+}
+
+///spreads the bits of x over the whole word, hashes of integers are often the integers themselves
+inline uint64_t mix_bits(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    return x;
+}
+
+///open addressing set of 64 bit keys, 0 marks free slots and is tracked separately
+class key_set {
+    std::vector<uint64_t> slots;
+    std::size_t count = 0;
+    bool hasZero = false;
+
+    void place(uint64_t key) {
+        const std::size_t mask = slots.size() - 1;
+        std::size_t i = static_cast<std::size_t>(mix_bits(key)) & mask;
+        while (slots[i] != 0)
+            i = (i + 1) & mask;
+        slots[i] = key;
+    }
+
+public:
+    key_set()
+        : slots(64, 0) {}
+
+    std::size_t size() const {
+        return count + (hasZero ? 1 : 0);
+    }
+
+    ///true if key wasn't contained yet
+    bool insert(uint64_t key) {
+        if (key == 0) {
+            const bool inserted = !hasZero;
+            hasZero = true;
+            return inserted;
+        }
+
+        const std::size_t mask = slots.size() - 1;
+        std::size_t i = static_cast<std::size_t>(mix_bits(key)) & mask;
+        while (slots[i] != 0) {
+            if (slots[i] == key)
+                return false;
+            i = (i + 1) & mask;
+        }
+        slots[i] = key;
+
+        //at most half full, so probe sequences stay short
+        if (2 * ++count > slots.size()) {
+            std::vector<uint64_t> old(slots.size() * 2, 0);
+            old.swap(slots);
+            for (uint64_t x : old)
+                if (x != 0)
+                    place(x);
+        }
+        return true;
+    }
+};
+
+///moves the first element of each key to the front and returns the end of those, the keys seen are tracked within a key_set (O(distinct) memory)
+///gives up if more than 7 / 8 of the first sixteenth of the data are distinct, the remaining elements are then kept as well and second is false
+template <typename Projection, typename It>
+std::pair<It, bool> hash_dedup(It first, It last) {
+    const auto probe = static_cast<std::size_t>(std::distance(first, last)) / 16;
+
+    key_set seen;
+    auto out = first;
+    std::size_t i = 0;
+    for (auto it = first; it != last; ++it, ++i) {
+        if (i == probe && 8 * seen.size() > 7 * probe)
+            return std::make_pair(out == it ? last : std::move(it, last, out), false);
+
+        if (seen.insert(static_cast<uint64_t>(Projection{}(*it)))) {
+            if (out != it)
+                *out = std::move(*it);
+            ++out;
+        }
+    }
+    return std::make_pair(out, true);
+}
+
+template <typename Compare, typename Projection, typename T>
+void sort_unique_by(T& data, std::false_type /*hash dedupable*/) {
+    sort_by<Compare, Projection>(data);
+    unique_by<Compare, Projection>(data);
+}
+
+///duplicates are dropped by hashing before sorting, so only the distinct elements are sorted
+template <typename Compare, typename Projection, typename T>
+void sort_unique_by(T& data, std::true_type /*hash dedupable*/) {
+    if (static_cast<std::size_t>(std::distance(std::begin(data), std::end(data))) < hash_dedup_min_size()) {
+        sort_unique_by<Compare, Projection>(data, std::false_type{});
+        return;
+    }
+
+    const auto kept = hash_dedup<Projection>(std::begin(data), std::end(data));
+    data.erase(kept.first, std::end(data));
+    sort_by<Compare, Projection>(data);
+    if (!kept.second)
+        unique_by<Compare, Projection>(data);
+}
+
+///counting sort writes each value once
+template <typename Compare, typename Projection, typename T>
+void sort_unique_by_counting(T& data, std::true_type /*counting sortable*/) {
+    using range = value_range<element_t<T>>;
+    if (std::distance(std::begin(data), std::end(data)) < (range::hi - range::lo) / 8)
+        sort_unique_by<Compare, Projection>(data, hash_dedupable<Compare, Projection, element_t<T>>{});
+    else
+        data.erase(counting_sort<Compare>(data, true), std::end(data));
+}
+
+template <typename Compare, typename Projection, typename T>
+void sort_unique_by_counting(T& data, std::false_type /*counting sortable*/) {
+    sort_unique_by<Compare, Projection>(data, hash_dedupable<Compare, Projection, element_t<T>>{});
+}
+
+///sorts data and removes elements with equivalent keys, integer keys are deduplicated before sorting (see hash_dedupable), small ranges while counting
+template <typename Compare, typename Projection, typename T>
+void sort_unique_by(T& data) {
+    sort_unique_by_counting<Compare, Projection>(data, counting_sortable<Compare, Projection, element_t<T>>{});
+}
+
+inline void prefetch(void const* p) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(p);
+#else
+    (void)p;
+#endif
+}
+
+///ranges of at most this many elements are searched linearly, about a cache line of small keys
+constexpr std::size_t linear_search_size() {
+    return 16;
+}
+
+///number of leading elements of [first, first + n) satisfying pred, which has to hold for a prefix of the range
+///branch free binary search, the final few elements are counted without branches so the count vectorizes
+template <typename It, typename Pred>
+std::size_t partition_pos(It first, std::size_t n, Pred pred) {
+    std::size_t lo = 0;
+    while (n > linear_search_size()) {
+        const std::size_t half = n / 2;
+        //without branches nothing is loaded speculatively, so both candidates of the next step are prefetched
+        const std::size_t next = (n - half) / 2;
+        prefetch(&first[lo + next - 1]);
+        prefetch(&first[lo + half + next - 1]);
+        lo += static_cast<std::size_t>(pred(first[lo + half - 1])) * half;
+        n -= half;
+    }
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < n; ++i)
+        count += static_cast<std::size_t>(pred(first[lo + i]));
+    return lo + count;
+}
+
+///partition_pos for many keys, pred(key, element), the searches of a batch advance in lockstep so their memory accesses overlap
+template <typename It, typename KeyIt, typename OutIt, typename Pred>
+void partition_pos_batch(It first, std::size_t n, KeyIt keys, KeyIt keysEnd, OutIt out, Pred pred) {
+    constexpr std::size_t lanes = 16;
+    std::size_t lo[lanes];
+
+    while (keys != keysEnd) {
+        KeyIt batch[lanes];
+        std::size_t m = 0;
+        for (; m < lanes && keys != keysEnd; ++m, ++keys)
+            batch[m] = keys;
+
+        for (std::size_t j = 0; j < m; ++j)
+            lo[j] = 0;
+
+        std::size_t len = n;
+        while (len > linear_search_size()) {
+            const std::size_t half = len / 2;
+            const std::size_t next = (len - half) / 2;
+            for (std::size_t j = 0; j < m; ++j) {
+                lo[j] += static_cast<std::size_t>(pred(*batch[j], first[lo[j] + half - 1])) * half;
+                prefetch(&first[lo[j] + next - 1]);
+            }
+            len -= half;
+        }
+
+        for (std::size_t j = 0; j < m; ++j) {
+            std::size_t count = 0;
+            for (std::size_t i = 0; i < len; ++i)
+                count += static_cast<std::size_t>(pred(*batch[j], first[lo[j] + i]));
+            *out = lo[j] + count;
+            ++out;
+        }
+    }
+}
+
+template <typename T>
+using const_iterator_t = decltype(std::begin(std::declval<T const&>()));
+
+///searches of data sorted by Compare on the keys of Projection
+template <typename T, typename Compare, typename Projection>
+struct sorted_search {
+    using key_type = typename std::decay<projected_t<Projection, element_t<T>>>::type;
+
+    static std::size_t size(T const& data) {
+        return static_cast<std::size_t>(std::distance(std::begin(data), std::end(data)));
+    }
+
+    static std::size_t lower(T const& data, key_type const& key) {
+        return partition_pos(std::begin(data), size(data), [&key](element_t<T> const& x) { return Compare{}(Projection{}(x), key); });
+    }
+
+    static std::size_t upper(T const& data, key_type const& key) {
+        return partition_pos(std::begin(data), size(data), [&key](element_t<T> const& x) { return !Compare{}(key, Projection{}(x)); });
+    }
+
+    template <typename KeyIt, typename OutIt>
+    static void lower_batch(T const& data, KeyIt keys, KeyIt keysEnd, OutIt out) {
+        partition_pos_batch(std::begin(data), size(data), keys, keysEnd, out, [](key_type const& key, element_t<T> const& x) { return Compare{}(Projection{}(x), key); });
+    }
+
+    static const_iterator_t<T> at(T const& data, std::size_t pos) {
+        return std::next(std::begin(data), static_cast<std::ptrdiff_t>(pos));
+    }
+
+    static bool contains(T const& data, key_type const& key) {
+        const std::size_t pos = lower(data, key);
+        return pos != size(data) && !Compare{}(key, Projection{}(*at(data, pos)));
+    }
+};
+
+}
+
+//------------------------------------------------------------------------------
+
+///sorted by Compare on the keys Projection returns for each element (e.g. a member or std::greater<> for descending order)
+///Compare and Projection are part of the type and have to be default constructible
+template <typename T, typename Compare, typename Projection>
+class Sorted : public FlaggedTBase<T> {
+    static_assert(std::is_default_constructible<Compare>::value && std::is_default_constructible<Projection>::value, "Sorted requires default constructible Compare and Projection");
+
+    using base = FlaggedTBase<T>;
+    using search = detail::sorted_search<T, Compare, Projection>;
+
+    friend struct detail::access;
+
+    ///for data which is sorted by construction, e.g. merged from sorted runs
+    Sorted(detail::trusted_t, T&& in)
+        : base(std::forward<T>(in)) {}
+
+public:
+    using key_compare = Compare;
+    using projection = Projection;
+    using key_type = typename search::key_type;
+    using const_iterator = detail::const_iterator_t<T>;
+
+    Sorted() = delete;
+
+    Sorted(Sorted const&) = default;
+    Sorted(Sorted&&) = default;
+    Sorted& operator=(Sorted const&) = default;
+    Sorted& operator=(Sorted&&) = default;
+
+    Sorted(T&& in)
+        : base(std::forward<T>(in)) {
+
+        detail::sort_by<Compare, Projection>(base::data);
+    }
+
+    ///position of the first element whose key isn't ordered before key
+    std::size_t rank(key_type const& key) const {
+        return search::lower(base::data, key);
+    }
+
+    ///rank of each key within [keys, keysEnd) written to out, interleaves the searches to hide memory latency
+    template <typename KeyIt, typename OutIt>
+    void ranks(KeyIt keys, KeyIt keysEnd, OutIt out) const {
+        search::lower_batch(base::data, keys, keysEnd, out);
+    }
+
+    ///first element whose key isn't ordered before key
+    const_iterator lower_bound(key_type const& key) const {
+        return search::at(base::data, search::lower(base::data, key));
+    }
+
+    ///first element whose key is ordered after key
+    const_iterator upper_bound(key_type const& key) const {
+        return search::at(base::data, search::upper(base::data, key));
+    }
+
+    std::pair<const_iterator, const_iterator> equal_range(key_type const& key) const {
+        return std::make_pair(lower_bound(key), upper_bound(key));
+    }
+
+    bool contains(key_type const& key) const {
+        return search::contains(base::data, key);
+    }
+};
+
+//------------------------------------------------------------------------------
+
+template <typename T>
+class Shuffled : public FlaggedTBase<T> {
+    using base = FlaggedTBase<T>;
+
+public:
+    Shuffled() = delete;
+
+    Shuffled(Shuffled const&) = default;
+    Shuffled(Shuffled&&) = default;
+    Shuffled& operator=(Shuffled const&) = default;
+    Shuffled& operator=(Shuffled&&) = default;
+
+    Shuffled(T&& in)
+        : base(std::forward<T>(in)) {
+
+        std::shuffle(std::begin(base::data), std::end(base::data));
+    }
+};
+
+//------------------------------------------------------------------------------
+
+template <typename T>
+class Unique : public FlaggedTBase<T> {
+    using base = FlaggedTBase<T>;
+
+    friend struct detail::access;
+
+    ///for data without adjacent duplicates by construction, e.g. loaded from a file which records the flag
+    Unique(detail::trusted_t, T&& in)
+        : base(std::forward<T>(in)) {}
+
+public:
+    Unique() = delete;
+
+    Unique(Unique const&) = default;
+    Unique(Unique&&) = default;
+    Unique& operator=(Unique const&) = default;
+    Unique& operator=(Unique&&) = default;
+
+    Unique(T&& in)
+        : base(std::forward<T>(in)) {
+
+        make_data_unique();
+    }
+
+private:
+    void make_data_unique() {
+        if (base::data.empty())
+            return;
+        base::data.erase(std::unique(std::begin(base::data), std::end(base::data)), std::end(base::data));
+    }
+};
+
+//------------------------------------------------------------------------------
+
+///unique and sorted by Compare on the keys of Projection, elements with equivalent keys are considered duplicates
+template <typename T, typename Compare, typename Projection>
+class UniqueAndSorted : public FlaggedTBase<T> {
+    static_assert(std::is_default_constructible<Compare>::value && std::is_default_constructible<Projection>::value, "UniqueAndSorted requires default constructible Compare and Projection");
+
+    using base = FlaggedTBase<T>;
+    using search = detail::sorted_search<T, Compare, Projection>;
+
+    friend struct detail::access;
+
+    ///for data which is unique and sorted by construction, e.g. decoded from a compressed set
+    UniqueAndSorted(detail::trusted_t, T&& in)
+        : base(std::forward<T>(in)) {}
+
+public:
+    using key_compare = Compare;
+    using projection = Projection;
+    using key_type = typename search::key_type;
+    using const_iterator = detail::const_iterator_t<T>;
+
+    UniqueAndSorted() = delete;
+
+    UniqueAndSorted(UniqueAndSorted const&) = default;
+    UniqueAndSorted(UniqueAndSorted&&) = default;
+    UniqueAndSorted& operator=(UniqueAndSorted const&) = default;
+    UniqueAndSorted& operator=(UniqueAndSorted&&) = default;
+
+    UniqueAndSorted(T&& in)
+        : base(std::forward<T>(in)) {
+
+        detail::sort_unique_by<Compare, Projection>(base::data);
+    }
+
+    UniqueAndSorted(Unique<T> in)
+        : base(std::move(in).unwrap()) {
+
+        detail::sort_by<Compare, Projection>(base::data);
+        detail::unique_by<Compare, Projection>(base::data);
+    }
+
+    UniqueAndSorted(Sorted<T, Compare, Projection> in)
+        : base(std::move(in).unwrap()) {
+
+        detail::unique_by<Compare, Projection>(base::data);
+    }
+
+    ///position of the first element whose key isn't ordered before key
+    std::size_t rank(key_type const& key) const {
+        return search::lower(base::data, key);
+    }
+
+    ///rank of each key within [keys, keysEnd) written to out, interleaves the searches to hide memory latency
+    template <typename KeyIt, typename OutIt>
+    void ranks(KeyIt keys, KeyIt keysEnd, OutIt out) const {
+        search::lower_batch(base::data, keys, keysEnd, out);
+    }
+
+    ///first element whose key isn't ordered before key
+    const_iterator lower_bound(key_type const& key) const {
+        return search::at(base::data, search::lower(base::data, key));
+    }
+
+    ///first element whose key is ordered after key
+    const_iterator upper_bound(key_type const& key) const {
+        return search::at(base::data, search::upper(base::data, key));
+    }
+
+    std::pair<const_iterator, const_iterator> equal_range(key_type const& key) const {
+        return std::make_pair(lower_bound(key), upper_bound(key));
+    }
+
+    bool contains(key_type const& key) const {
+        return search::contains(base::data, key);
+    }
+};
+
+}
+
+#endif // FLAGGEDT_ORDERING_H
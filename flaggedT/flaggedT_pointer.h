@@ -0,0 +1,55 @@
+/*
+    Copyright (c) 2016 Martin Buck
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//NonNull
+
+#ifndef FLAGGEDT_POINTER_H
+#define FLAGGEDT_POINTER_H
+
+#include <utility>
+
+#include "flaggedT_base.h"
+
+FLAGGEDT_EXPORT namespace flaggedT {
+
+//------------------------------------------------------------------------------
+
+template <typename T>
+class NonNull : public FlaggedTBase<T> {
+    using base = FlaggedTBase<T>;
+
+public:
+    NonNull() = delete;
+    NonNull(nullptr_t) = delete;
+
+    NonNull(NonNull const&) = default;
+    NonNull(NonNull&&) = default;
+    NonNull& operator=(NonNull const&) = default;
+    NonNull& operator=(NonNull&&) = default;
+
+    ///THROWS
+    explicit constexpr NonNull(T&& in)
+        : base(std::forward<T>(in)) {
+
+        if (!is_valid(base::data))
+            detail::violated(FlaggedTError("Can't pass nullptr to constructor of NonNull", FlagKind::NonNull, Violation::Null));
+    }
+
+    static constexpr bool is_valid(T const& in) {
+        return nullptr != in;
+    }
+};
+
+}
+
+#endif // FLAGGEDT_POINTER_H
@@ -0,0 +1,909 @@
+/*
+    Copyright (c) 2016 Martin Buck
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//compact representations of UniqueAndSorted sets of unsigned integers and UniqueAndSorted with a Bloom filter
+
+#ifndef FLAGGEDT_SET_H
+#define FLAGGEDT_SET_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "flaggedT_numeric.h"
+#include "flaggedT_ordering.h"
+
+FLAGGEDT_EXPORT namespace flaggedT {
+
+//------------------------------------------------------------------------------
+
+namespace detail {
+
+///the builtin is a library call unless the target has an instruction for it, the bit parallel fallback also vectorizes
+inline unsigned popcount(std::uint64_t x) {
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__POPCNT__) || defined(__aarch64__))
+    return static_cast<unsigned>(__builtin_popcountll(x));
+#else
+    x = x - ((x >> 1) & 0x5555555555555555ull);
+    x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    return static_cast<unsigned>((x * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+///index of the lowest set bit (x != 0)
+inline unsigned lowest_bit(std::uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(x));
+#else
+    unsigned n = 0;
+    for (; !(x & 1); x >>= 1)
+        ++n;
+    return n;
+#endif
+}
+
+///floor(log2(x)) (x != 0)
+inline unsigned floor_log2(std::uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63u - static_cast<unsigned>(__builtin_clzll(x));
+#else
+    unsigned n = 0;
+    while (x >>= 1)
+        ++n;
+    return n;
+#endif
+}
+
+///index of the r-th (0 based) set bit of x (r < popcount(x)), skips whole bytes first
+inline unsigned select_in_word(std::uint64_t x, unsigned r) {
+    unsigned shift = 0;
+    for (unsigned count; r >= (count = popcount(x & 0xFF)); x >>= 8, shift += 8)
+        r -= count;
+    for (; r > 0; --r)
+        x &= x - 1;
+    return shift + lowest_bit(x);
+}
+
+}
+
+//------------------------------------------------------------------------------
+
+///UniqueAndSorted unsigned integers in Elias-Fano encoding, taking 2 + log2(max / size) bits per element
+///the low bits of each element are bit-packed, the high bits are stored in unary as the gaps between set bits of a bit vector
+///lookups, lower bounds and random access work on the encoded data, skip pointers to every 256th set and unset bit bound their cost
+template <typename T>
+class CompressedSortedSet {
+    static_assert(std::is_integral<T>::value && std::is_unsigned<T>::value, "CompressedSortedSet requires unsigned integers");
+
+    ///distance of the skip pointers in set / unset bits
+    static constexpr std::size_t sample_rate = 256;
+
+
+    std::size_t n = 0;
+    unsigned lowBits = 0;
+    std::size_t upperBits = 0;
+    std::vector<std::uint64_t> lower;     //lowBits bits per element
+    std::vector<std::uint64_t> upper;     //the i-th element x sets bit (x >> lowBits) + i, bucket h is terminated by the h-th unset bit
+    std::vector<std::size_t> oneSamples;  //position of every sample_rate-th set bit within upper
+    std::vector<std::size_t> zeroSamples; //position of every sample_rate-th unset bit within upper
+
+public:
+    ///decodes the elements one by one, without decompressing the set
+    class const_iterator {
+        friend class CompressedSortedSet;
+
+        CompressedSortedSet const* set = nullptr;
+        std::size_t i = 0;   //index of the current element
+        std::size_t pos = 0; //position of its set bit within upper
+
+        const_iterator(CompressedSortedSet const* set, std::size_t i, std::size_t pos)
+            : set(set)
+            , i(i)
+            , pos(pos) {}
+
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T const*;
+        using reference = T;
+
+        const_iterator() = default;
+
+        T operator*() const {
+            return set->value(i, pos);
+        }
+
+        const_iterator& operator++() {
+            ++i;
+            pos = i < set->n ? set->next_one(pos + 1) : set->upperBits;
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            auto result = *this;
+            ++*this;
+            return result;
+        }
+
+        ///advances to the first element not smaller than x
+        ///nearby buckets are reached by counting unset bits from the current position, far ones via the skip pointers
+        void skip_to(T x) {
+            if (i == set->n || !(**this < x))
+                return;
+            const std::uint64_t h = static_cast<std::uint64_t>(x) >> set->lowBits;
+            const std::size_t current = pos - i;
+            if (h >= set->upperBits - set->n)
+                *this = set->end();
+            else if (h == current)
+                *this = set->scan_bucket(x, pos, i);
+            else if (h - current > sample_rate)
+                *this = set->lower_bound(x);
+            else {
+                const std::size_t start = set->select_from(pos, static_cast<std::size_t>(h - current) - 1, false) + 1;
+                *this = set->scan_bucket(x, start, start - static_cast<std::size_t>(h));
+            }
+        }
+
+        bool operator==(const_iterator const& other) const {
+            return i == other.i;
+        }
+
+        bool operator!=(const_iterator const& other) const {
+            return i != other.i;
+        }
+    };
+
+    CompressedSortedSet() = delete;
+
+    CompressedSortedSet(CompressedSortedSet const&) = default;
+    CompressedSortedSet(CompressedSortedSet&&) = default;
+    CompressedSortedSet& operator=(CompressedSortedSet const&) = default;
+    CompressedSortedSet& operator=(CompressedSortedSet&&) = default;
+
+    template <typename C>
+    explicit CompressedSortedSet(UniqueAndSorted<C> const& in) {
+        using V = typename std::decay<decltype(*std::begin(in.get()))>::type;
+        static_assert(std::is_integral<V>::value && std::is_unsigned<V>::value && sizeof(V) <= sizeof(T), "CompressedSortedSet requires unsigned integers no wider than T");
+
+        encode(std::begin(in.get()), std::end(in.get()));
+    }
+
+    std::size_t size() const {
+        return n;
+    }
+
+    bool empty() const {
+        return n == 0;
+    }
+
+    ///memory used by the encoded set in bytes
+    std::size_t bytes() const {
+        return sizeof(*this)
+            + (lower.capacity() + upper.capacity()) * sizeof(std::uint64_t)
+            + (oneSamples.capacity() + zeroSamples.capacity()) * sizeof(std::size_t);
+    }
+
+    ///i-th smallest element (i < size())
+    T operator[](std::size_t i) const {
+        return value(i, select(i, true));
+    }
+
+    ///number of elements smaller than x
+    std::size_t rank(T x) const {
+        return lower_bound(x).i;
+    }
+
+    ///first element not smaller than x
+    const_iterator lower_bound(T x) const {
+        const std::uint64_t h = static_cast<std::uint64_t>(x) >> lowBits;
+        if (n == 0 || h >= upperBits - n)
+            return end();
+
+        const std::size_t pos = h == 0 ? 0 : select(static_cast<std::size_t>(h) - 1, false) + 1;
+        return scan_bucket(x, pos, pos - static_cast<std::size_t>(h));
+    }
+
+    bool contains(T x) const {
+        auto it = lower_bound(x);
+        return it != end() && *it == x;
+    }
+
+    const_iterator begin() const {
+        return n == 0 ? end() : const_iterator(this, 0, next_one(0));
+    }
+
+    const_iterator end() const {
+        return const_iterator(this, n, upperBits);
+    }
+
+    UniqueAndSorted<std::vector<T>> decompress() const {
+        std::vector<T> result;
+        result.reserve(n);
+        for (auto x : *this)
+            result.push_back(x);
+        return detail::access::make_trusted<UniqueAndSorted<std::vector<T>>>(std::move(result));
+    }
+
+private:
+    std::uint64_t low_mask() const {
+        return (std::uint64_t(1) << lowBits) - 1;
+    }
+
+    bool bit(std::size_t pos) const {
+        return (upper[pos / 64] >> (pos % 64)) & 1;
+    }
+
+    std::uint64_t low_at(std::size_t i) const {
+        if (lowBits == 0)
+            return 0;
+        const std::size_t b = i * lowBits;
+        const std::size_t offset = b % 64;
+        std::uint64_t result = lower[b / 64] >> offset;
+        if (offset + lowBits > 64)
+            result |= lower[b / 64 + 1] << (64 - offset);
+        return result & low_mask();
+    }
+
+    T value(std::size_t i, std::size_t pos) const {
+        return static_cast<T>((static_cast<std::uint64_t>(pos - i) << lowBits) | low_at(i));
+    }
+
+    ///position of the first set bit at or after pos, upperBits if there is none
+    std::size_t next_one(std::size_t pos) const {
+        if (pos >= upperBits)
+            return upperBits;
+        std::size_t w = pos / 64;
+        std::uint64_t word = upper[w] & (~std::uint64_t(0) << (pos % 64));
+        while (word == 0) {
+            if (++w == upper.size())
+                return upperBits;
+            word = upper[w];
+        }
+        return w * 64 + detail::lowest_bit(word);
+    }
+
+    ///first element not smaller than x, starting at the element i at pos within the bucket of x
+    const_iterator scan_bucket(T x, std::size_t pos, std::size_t i) const {
+        const std::uint64_t low = static_cast<std::uint64_t>(x) & low_mask();
+        for (; bit(pos); ++pos, ++i)
+            if (low_at(i) >= low)
+                return const_iterator(this, i, pos);
+
+        //every element of the bucket is smaller, the next one is within a later bucket
+        return i < n ? const_iterator(this, i, next_one(pos)) : end();
+    }
+
+    ///position of the r-th (0 based) set or unset bit, starting at the skip pointer before it
+    std::size_t select(std::size_t r, bool ones) const {
+        auto const& samples = ones ? oneSamples : zeroSamples;
+        return select_from(samples[r / sample_rate], r % sample_rate, ones);
+    }
+
+    ///position of the r-th (0 based) set or unset bit at or after start
+    std::size_t select_from(std::size_t start, std::size_t r, bool ones) const {
+        const std::uint64_t flip = ones ? 0 : ~std::uint64_t(0);
+        std::size_t w = start / 64;
+        std::uint64_t word = (upper[w] ^ flip) & (~std::uint64_t(0) << (start % 64));
+        for (;;) {
+            const unsigned count = detail::popcount(word);
+            if (r < count)
+                return w * 64 + detail::select_in_word(word, static_cast<unsigned>(r));
+            r -= count;
+            word = upper[++w] ^ flip;
+        }
+    }
+
+    template <typename It>
+    void encode(It first, It last) {
+        n = static_cast<std::size_t>(std::distance(first, last));
+        if (n == 0)
+            return;
+
+        const auto maxValue = static_cast<std::uint64_t>(first[static_cast<std::ptrdiff_t>(n - 1)]);
+        lowBits = maxValue / n > 0 ? detail::floor_log2(maxValue / n) : 0;
+        const std::size_t buckets = static_cast<std::size_t>(maxValue >> lowBits) + 1;
+        upperBits = n + buckets;
+
+        lower.assign((n * lowBits + 63) / 64, 0);
+        upper.assign((upperBits + 63) / 64, 0);
+        oneSamples.reserve(n / sample_rate + 1);
+        zeroSamples.reserve(buckets / sample_rate + 1);
+
+        std::size_t zeros = 0;
+        for (std::size_t i = 0; i < n; ++i, ++first) {
+            const auto x = static_cast<std::uint64_t>(*first);
+            const auto h = static_cast<std::size_t>(x >> lowBits);
+
+            //buckets before h are terminated before the set bit of x
+            for (; zeros < h; ++zeros)
+                if (zeros % sample_rate == 0)
+                    zeroSamples.push_back(zeros + i);
+
+            const std::size_t pos = h + i;
+            upper[pos / 64] |= std::uint64_t(1) << (pos % 64);
+            if (i % sample_rate == 0)
+                oneSamples.push_back(pos);
+
+            if (lowBits > 0) {
+                const std::uint64_t low = x & low_mask();
+                const std::size_t b = i * lowBits;
+                lower[b / 64] |= low << (b % 64);
+                if (b % 64 + lowBits > 64)
+                    lower[b / 64 + 1] |= low >> (64 - b % 64);
+            }
+        }
+        for (; zeros < buckets; ++zeros)
+            if (zeros % sample_rate == 0)
+                zeroSamples.push_back(zeros + n);
+    }
+};
+
+///elements contained in both sets, walks the smaller set and skips through the larger one
+template <typename T>
+UniqueAndSorted<std::vector<T>> intersection(CompressedSortedSet<T> const& a, CompressedSortedSet<T> const& b) {
+    auto const& small = a.size() <= b.size() ? a : b;
+    auto const& large = a.size() <= b.size() ? b : a;
+
+    std::vector<T> result;
+    auto it = large.begin();
+    for (auto x : small) {
+        it.skip_to(x);
+        if (it == large.end())
+            break;
+        if (*it == x)
+            result.push_back(x);
+    }
+    return detail::access::make_trusted<UniqueAndSorted<std::vector<T>>>(std::move(result));
+}
+
+//------------------------------------------------------------------------------
+
+namespace detail {
+
+enum class roaring_kind : std::uint8_t {
+    array,
+    bitmap,
+    run
+};
+
+///values of one 2^16 chunk of a RoaringBitmap as sorted array, bitmap or runs, whichever is smallest
+struct roaring_container {
+    ///array containers hold at most this many values, beyond that a bitmap is smaller
+    static constexpr std::uint32_t max_array = 4096;
+    static constexpr std::size_t words = 1024;
+
+    std::uint16_t key = 0;
+    roaring_kind kind = roaring_kind::array;
+    std::uint32_t cardinality = 0;
+    std::vector<std::uint16_t> values; //sorted low bits (array) or start and length - 1 of each run (run)
+    std::vector<std::uint64_t> bits;   //2^16 bits (bitmap)
+
+    bool contains(std::uint16_t low) const {
+        switch (kind) {
+        case roaring_kind::array:
+            return std::binary_search(values.begin(), values.end(), low);
+        case roaring_kind::bitmap:
+            return (bits[low / 64] >> (low % 64)) & 1;
+        case roaring_kind::run: {
+            //number of runs starting at or before low
+            std::size_t lo = 0;
+            std::size_t hi = values.size() / 2;
+            while (lo < hi) {
+                const std::size_t mid = (lo + hi) / 2;
+                if (values[2 * mid] <= low)
+                    lo = mid + 1;
+                else
+                    hi = mid;
+            }
+            return lo > 0 && low - values[2 * lo - 2] <= values[2 * lo - 1];
+        }
+        }
+        return false;
+    }
+
+    ///calls f with each value in ascending order
+    template <typename F>
+    void for_each(F f) const {
+        switch (kind) {
+        case roaring_kind::array:
+            for (auto v : values)
+                f(v);
+            break;
+        case roaring_kind::bitmap:
+            for (std::size_t w = 0; w < words; ++w)
+                for (std::uint64_t word = bits[w]; word != 0; word &= word - 1)
+                    f(static_cast<std::uint16_t>(w * 64 + lowest_bit(word)));
+            break;
+        case roaring_kind::run:
+            for (std::size_t r = 0; r < values.size(); r += 2)
+                for (std::uint32_t v = values[r]; v <= std::uint32_t(values[r]) + values[r + 1]; ++v)
+                    f(static_cast<std::uint16_t>(v));
+            break;
+        }
+    }
+
+    ///the values as bitmap, whatever the kind
+    std::vector<std::uint64_t> as_bitmap() const {
+        if (kind == roaring_kind::bitmap)
+            return bits;
+        std::vector<std::uint64_t> result(words, 0);
+        for_each([&result](std::uint16_t v) {
+            result[v / 64] |= std::uint64_t(1) << (v % 64);
+        });
+        return result;
+    }
+
+    std::size_t bytes() const {
+        return sizeof(*this) + values.capacity() * sizeof(std::uint16_t) + bits.capacity() * sizeof(std::uint64_t);
+    }
+
+    ///switches to the smallest kind, cardinality must be up to date
+    void optimize() {
+        std::size_t runs = 0;
+        switch (kind) {
+        case roaring_kind::array:
+            for (std::size_t i = 0; i < values.size(); ++i)
+                runs += i == 0 || values[i] != values[i - 1] + 1;
+            break;
+        case roaring_kind::bitmap: {
+            //a run starts at each set bit whose lower neighbour is unset
+            std::uint64_t carry = 0;
+            for (auto word : bits) {
+                runs += popcount(word & ~((word << 1) | carry));
+                carry = word >> 63;
+            }
+            break;
+        }
+        case roaring_kind::run:
+            runs = values.size() / 2;
+            break;
+        }
+
+        const std::size_t arrayBytes = 2 * std::size_t(cardinality);
+        const std::size_t bitmapBytes = 8 * words;
+        const roaring_kind best = 4 * runs < std::min(arrayBytes, bitmapBytes)
+            ? roaring_kind::run
+            : cardinality <= max_array ? roaring_kind::array : roaring_kind::bitmap;
+        if (best == kind)
+            return;
+
+        std::vector<std::uint16_t> newValues;
+        std::vector<std::uint64_t> newBits;
+        if (best == roaring_kind::bitmap)
+            newBits = as_bitmap();
+        else if (best == roaring_kind::array) {
+            newValues.reserve(cardinality);
+            for_each([&newValues](std::uint16_t v) {
+                newValues.push_back(v);
+            });
+        } else {
+            newValues.reserve(2 * runs);
+            for_each([&newValues](std::uint16_t v) {
+                const auto n = newValues.size();
+                if (n > 0 && v == newValues[n - 2] + newValues[n - 1] + 1)
+                    ++newValues[n - 1];
+                else {
+                    newValues.push_back(v);
+                    newValues.push_back(0);
+                }
+            });
+        }
+        values = std::move(newValues);
+        bits = std::move(newBits);
+        kind = best;
+    }
+};
+
+///word by word kernel over two bitmaps, returns the cardinality of the result
+template <typename Op>
+std::uint32_t combine_bitmaps(std::vector<std::uint64_t>& inout, std::vector<std::uint64_t> const& other, Op op) {
+    std::uint32_t cardinality = 0;
+    for (std::size_t w = 0; w < roaring_container::words; ++w) {
+        inout[w] = op(inout[w], other[w]);
+        cardinality += popcount(inout[w]);
+    }
+    return cardinality;
+}
+
+inline roaring_container intersect(roaring_container const& a, roaring_container const& b) {
+    roaring_container result;
+    result.key = a.key;
+    if (a.kind == roaring_kind::array || b.kind == roaring_kind::array) {
+        roaring_container const& small = a.kind == roaring_kind::array ? a : b;
+        roaring_container const& large = a.kind == roaring_kind::array ? b : a;
+        if (large.kind == roaring_kind::array)
+            std::set_intersection(small.values.begin(), small.values.end(), large.values.begin(), large.values.end(), std::back_inserter(result.values));
+        else
+            for (auto v : small.values)
+                if (large.contains(v))
+                    result.values.push_back(v);
+        result.cardinality = static_cast<std::uint32_t>(result.values.size());
+    } else {
+        result.kind = roaring_kind::bitmap;
+        result.bits = a.as_bitmap();
+        result.cardinality = combine_bitmaps(result.bits, b.kind == roaring_kind::bitmap ? b.bits : b.as_bitmap(), [](std::uint64_t x, std::uint64_t y) {
+            return x & y;
+        });
+    }
+    result.optimize();
+    return result;
+}
+
+inline roaring_container unite(roaring_container const& a, roaring_container const& b) {
+    roaring_container result;
+    result.key = a.key;
+    if (a.kind == roaring_kind::array && b.kind == roaring_kind::array && a.cardinality + b.cardinality <= roaring_container::max_array) {
+        std::set_union(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(), std::back_inserter(result.values));
+        result.cardinality = static_cast<std::uint32_t>(result.values.size());
+    } else {
+        result.kind = roaring_kind::bitmap;
+        result.bits = a.as_bitmap();
+        result.cardinality = combine_bitmaps(result.bits, b.kind == roaring_kind::bitmap ? b.bits : b.as_bitmap(), [](std::uint64_t x, std::uint64_t y) {
+            return x | y;
+        });
+    }
+    result.optimize();
+    return result;
+}
+
+}
+
+//------------------------------------------------------------------------------
+
+///UniqueAndSorted 32 bit unsigned integers as roaring bitmap
+///the values of each 2^16 chunk are stored as sorted array, bitmap or runs, whichever is smallest
+///intersections and unions work chunk by chunk, on bitmaps word by word
+class RoaringBitmap {
+    using container = detail::roaring_container;
+
+    std::vector<container> containers; //sorted by key, none empty
+
+    RoaringBitmap() = default;
+
+public:
+    RoaringBitmap(RoaringBitmap const&) = default;
+    RoaringBitmap(RoaringBitmap&&) = default;
+    RoaringBitmap& operator=(RoaringBitmap const&) = default;
+    RoaringBitmap& operator=(RoaringBitmap&&) = default;
+
+    template <typename C>
+    explicit RoaringBitmap(UniqueAndSorted<C> const& in) {
+        using V = typename std::decay<decltype(*std::begin(in.get()))>::type;
+        static_assert(std::is_integral<V>::value && std::is_unsigned<V>::value && sizeof(V) <= 4, "RoaringBitmap requires unsigned integers of up to 32 bits");
+
+        for (auto x : in.get()) {
+            const auto key = static_cast<std::uint16_t>(std::uint32_t(x) >> 16);
+            if (containers.empty() || containers.back().key != key) {
+                if (!containers.empty())
+                    containers.back().optimize();
+                containers.emplace_back();
+                containers.back().key = key;
+            }
+            containers.back().values.push_back(static_cast<std::uint16_t>(x));
+            ++containers.back().cardinality;
+        }
+        if (!containers.empty())
+            containers.back().optimize();
+    }
+
+    std::size_t size() const {
+        std::size_t result = 0;
+        for (auto const& c : containers)
+            result += c.cardinality;
+        return result;
+    }
+
+    bool empty() const {
+        return containers.empty();
+    }
+
+    ///memory used by the bitmap in bytes
+    std::size_t bytes() const {
+        std::size_t result = sizeof(*this);
+        for (auto const& c : containers)
+            result += c.bytes();
+        return result;
+    }
+
+    bool contains(std::uint32_t x) const {
+        const auto key = static_cast<std::uint16_t>(x >> 16);
+        auto it = std::lower_bound(containers.begin(), containers.end(), key, [](container const& c, std::uint16_t k) {
+            return c.key < k;
+        });
+        return it != containers.end() && it->key == key && it->contains(static_cast<std::uint16_t>(x));
+    }
+
+    UniqueAndSorted<std::vector<std::uint32_t>> decompress() const {
+        std::vector<std::uint32_t> result;
+        result.reserve(size());
+        for (auto const& c : containers) {
+            const std::uint32_t high = std::uint32_t(c.key) << 16;
+            c.for_each([&](std::uint16_t low) {
+                result.push_back(high | low);
+            });
+        }
+        return detail::access::make_trusted<UniqueAndSorted<std::vector<std::uint32_t>>>(std::move(result));
+    }
+
+    friend RoaringBitmap operator&(RoaringBitmap const& a, RoaringBitmap const& b) {
+        return combine(a, b, false);
+    }
+
+    friend RoaringBitmap operator|(RoaringBitmap const& a, RoaringBitmap const& b) {
+        return combine(a, b, true);
+    }
+
+private:
+    ///merges the chunks of a and b, chunks within only one of them are kept for unions
+    static RoaringBitmap combine(RoaringBitmap const& a, RoaringBitmap const& b, bool unite) {
+        RoaringBitmap result;
+        auto i = a.containers.begin();
+        auto j = b.containers.begin();
+        while (i != a.containers.end() && j != b.containers.end()) {
+            if (i->key < j->key) {
+                if (unite)
+                    result.containers.push_back(*i);
+                ++i;
+            } else if (j->key < i->key) {
+                if (unite)
+                    result.containers.push_back(*j);
+                ++j;
+            } else {
+                auto c = unite ? detail::unite(*i, *j) : detail::intersect(*i, *j);
+                if (c.cardinality > 0)
+                    result.containers.push_back(std::move(c));
+                ++i;
+                ++j;
+            }
+        }
+        if (unite) {
+            result.containers.insert(result.containers.end(), i, a.containers.end());
+            result.containers.insert(result.containers.end(), j, b.containers.end());
+        }
+        return result;
+    }
+};
+
+//------------------------------------------------------------------------------
+
+///set of BoundedInclusive<T, MIN, MAX> as one bit per possible value, its storage size follows from the bounds
+///insert, erase and contains touch a single word, set operations and size combine whole words
+template <typename T, int64_t MIN, int64_t MAX>
+class BoundedSet {
+    static_assert(std::is_integral<T>::value, "BoundedSet requires integers");
+    static_assert(MIN <= MAX && MAX - MIN < (int64_t(1) << 16), "BoundedSet requires MAX - MIN < 2^16");
+
+public:
+    using value_type = BoundedInclusive<T, MIN, MAX>;
+
+    ///number of possible values
+    static constexpr std::size_t capacity = static_cast<std::size_t>(MAX - MIN) + 1;
+
+private:
+    static constexpr std::size_t words = (capacity + 63) / 64;
+
+    std::array<std::uint64_t, words> bits = {};
+
+    static std::size_t index(value_type const& x) {
+        return static_cast<std::size_t>(static_cast<int64_t>(x.get()) - MIN);
+    }
+
+    static std::uint64_t mask(value_type const& x) {
+        return std::uint64_t(1) << (index(x) % 64);
+    }
+
+public:
+    BoundedSet() = default;
+
+    BoundedSet(BoundedSet const&) = default;
+    BoundedSet(BoundedSet&&) = default;
+    BoundedSet& operator=(BoundedSet const&) = default;
+    BoundedSet& operator=(BoundedSet&&) = default;
+
+    template <typename C>
+    explicit BoundedSet(UniqueAndSorted<C> const& in) {
+        for (auto const& x : in.get())
+            insert(x);
+    }
+
+    template <typename C>
+    explicit BoundedSet(Unique<C> const& in) {
+        for (auto const& x : in.get())
+            insert(x);
+    }
+
+    ///false if x was already contained
+    bool insert(value_type const& x) {
+        std::uint64_t& word = bits[index(x) / 64];
+        const bool inserted = !(word & mask(x));
+        word |= mask(x);
+        return inserted;
+    }
+
+    ///false if x wasn't contained
+    bool erase(value_type const& x) {
+        std::uint64_t& word = bits[index(x) / 64];
+        const bool erased = (word & mask(x)) != 0;
+        word &= ~mask(x);
+        return erased;
+    }
+
+    bool contains(value_type const& x) const {
+        return (bits[index(x) / 64] & mask(x)) != 0;
+    }
+
+    std::size_t size() const {
+        std::size_t result = 0;
+        for (auto word : bits)
+            result += detail::popcount(word);
+        return result;
+    }
+
+    bool empty() const {
+        for (auto word : bits)
+            if (word != 0)
+                return false;
+        return true;
+    }
+
+    void clear() {
+        bits.fill(0);
+    }
+
+    UniqueAndSorted<std::vector<value_type>> decompress() const {
+        std::vector<value_type> result;
+        result.reserve(size());
+        for (std::size_t w = 0; w < words; ++w)
+            for (std::uint64_t word = bits[w]; word != 0; word &= word - 1)
+                result.push_back(detail::access::make_trusted<value_type>(static_cast<T>(MIN + static_cast<int64_t>(w * 64 + detail::lowest_bit(word)))));
+        return detail::access::make_trusted<UniqueAndSorted<std::vector<value_type>>>(std::move(result));
+    }
+
+    friend BoundedSet operator&(BoundedSet a, BoundedSet const& b) {
+        for (std::size_t w = 0; w < words; ++w)
+            a.bits[w] &= b.bits[w];
+        return a;
+    }
+
+    friend BoundedSet operator|(BoundedSet a, BoundedSet const& b) {
+        for (std::size_t w = 0; w < words; ++w)
+            a.bits[w] |= b.bits[w];
+        return a;
+    }
+
+    friend bool operator==(BoundedSet const& a, BoundedSet const& b) {
+        return a.bits == b.bits;
+    }
+
+    friend bool operator!=(BoundedSet const& a, BoundedSet const& b) {
+        return !(a == b);
+    }
+};
+//------------------------------------------------------------------------------
+
+///UniqueAndSorted plus a blocked Bloom filter of its keys, sized for the false positive rate passed on construction
+///contains() asks the filter first, which rejects all but about that share of missing keys within a single cache line, only probable hits are searched for
+///each key sets its bits within one block of 512 bits, so the filter takes more bits than an unblocked one of the same rate (a tenth more at 10%, two fifths at 0.1%)
+///equivalent keys have to hash the same, so only std::less and std::greater are supported. Passed as UniqueAndSorted, the filter isn't used
+template <typename T, typename Compare, typename Projection>
+class BloomFiltered : public UniqueAndSorted<T, Compare, Projection> {
+    static_assert(detail::counting_direction<Compare>::value != 0, "BloomFiltered requires std::less or std::greater");
+
+    using base = UniqueAndSorted<T, Compare, Projection>;
+
+public:
+    using typename base::key_type;
+    using rate = BoundedExclusive<double, 0, 1>;
+
+private:
+    static constexpr std::size_t block_bits = 512;
+
+    ///a cache line, the alignment holds for copies of the filter as well (in C++14 the allocator may ignore it, which costs speed only)
+    struct alignas(64) block {
+        std::uint64_t words[block_bits / 64];
+    };
+
+    std::vector<block> blocks;
+    unsigned hashes = 0;
+
+public:
+    BloomFiltered() = delete;
+
+    BloomFiltered(BloomFiltered const&) = default;
+    BloomFiltered(BloomFiltered&&) = default;
+    BloomFiltered& operator=(BloomFiltered const&) = default;
+    BloomFiltered& operator=(BloomFiltered&&) = default;
+
+    BloomFiltered(T&& in, rate falsePositiveRate = rate(0.01))
+        : base(std::forward<T>(in)) {
+
+        build(falsePositiveRate.get());
+    }
+
+    ///only builds the filter, the data is already unique and sorted
+    BloomFiltered(base in, rate falsePositiveRate = rate(0.01))
+        : base(std::move(in)) {
+
+        build(falsePositiveRate.get());
+    }
+
+    BloomFiltered(Unique<T> in, rate falsePositiveRate = rate(0.01))
+        : base(std::move(in)) {
+
+        build(falsePositiveRate.get());
+    }
+
+    ///size of the filter
+    std::size_t bytes() const {
+        return blocks.size() * sizeof(block);
+    }
+
+    ///false if key is certainly missing, true if it's contained or (at about the false positive rate) a false positive
+    bool might_contain(key_type const& key) const {
+        const std::uint64_t h = hash(key);
+        std::uint64_t const* words = blocks[block_of(h)].words;
+        std::size_t bit = h & (block_bits - 1);
+        const std::size_t step = ((h >> 9) & (block_bits - 1)) | 1; //odd, so the bits differ
+        bool result = true;
+        for (unsigned i = 0; i < hashes; ++i, bit = (bit + step) & (block_bits - 1))
+            result &= ((words[bit / 64] >> (bit % 64)) & 1) != 0;
+        return result;
+    }
+
+    bool contains(key_type const& key) const {
+        return might_contain(key) && base::contains(key);
+    }
+
+private:
+    static std::uint64_t hash(key_type const& key) {
+        return detail::mix_bits(static_cast<std::uint64_t>(std::hash<key_type>{}(key)));
+    }
+
+    ///the block is chosen by the high bits of h, the bits within it by the low ones
+    std::size_t block_of(std::uint64_t h) const {
+        return static_cast<std::size_t>(((h >> 32) * blocks.size()) >> 32);
+    }
+
+    void build(double falsePositiveRate) {
+        auto first = std::begin(base::get());
+        const auto n = static_cast<std::size_t>(std::distance(first, std::end(base::get())));
+
+        //optimum of an unblocked filter: log2(1 / rate) hashes at 1.44 bits each, the blocks need more the lower the rate
+        const double log2Rate = -std::log2(falsePositiveRate);
+        hashes = static_cast<unsigned>(std::min(16.0, std::max(1.0, std::round(log2Rate))));
+        const double bits = (1.0 + log2Rate / 25) * 1.44 * log2Rate * static_cast<double>(n);
+        const std::size_t count = std::max<std::size_t>(1, static_cast<std::size_t>(std::ceil(bits / block_bits)));
+
+        blocks.assign(std::min<std::size_t>(count, std::size_t(1) << 32), block{});
+        for (std::size_t i = 0; i < n; ++i) {
+            const std::uint64_t h = hash(Projection{}(first[i]));
+            std::uint64_t* words = blocks[block_of(h)].words;
+            std::size_t bit = h & (block_bits - 1);
+            const std::size_t step = ((h >> 9) & (block_bits - 1)) | 1;
+            for (unsigned k = 0; k < hashes; ++k, bit = (bit + step) & (block_bits - 1))
+                words[bit / 64] |= std::uint64_t(1) << (bit % 64);
+        }
+    }
+};
+}
+
+#endif // FLAGGEDT_SET_H
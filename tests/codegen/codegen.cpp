@@ -0,0 +1,152 @@
+/*
+    Copyright (c) 2016 Martin Buck
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+//pairs of functions flagged_X / raw_X doing the same work, once via flagged types, once on the raw types
+//compare_codegen.cmake fails if any flagged_X has more instructions than raw_X (ignoring cold paths and padding)
+//raw_X contains the same validation as flagged_X where flagged_X validates
+
+#include <utility>
+
+#include "flaggedT.h"
+
+using namespace flaggedT;
+
+[[noreturn]] void raw_fail();
+
+//------------------------------------------------------------------------------
+//passing and accessing (a wrapper with non-trivial copy members would be passed via the stack)
+
+int flagged_positive_get(Positive<int> p) {
+    return p.get() * 3;
+}
+
+int raw_positive_get(int p) {
+    return p * 3;
+}
+
+double flagged_bounded_double_get(BoundedInclusive<double, 0, 1> a, BoundedExclusive<double, -1, 1> b) {
+    return a.get() * b.get();
+}
+
+double raw_bounded_double_get(double a, double b) {
+    return a * b;
+}
+
+int flagged_nonnull_deref(NonNull<int*> p) {
+    return *p.get();
+}
+
+int raw_nonnull_deref(int* p) {
+    return *p;
+}
+
+double flagged_immutable_get(Immutable<double> a, Immutable<double> b) {
+    return a.get() + b.get();
+}
+
+double raw_immutable_get(double a, double b) {
+    return a + b;
+}
+
+int flagged_implicit_unwrap(NonNegative<int> a) {
+    int const& x = a;
+    return x + 1;
+}
+
+int raw_implicit_unwrap(int a) {
+    return a + 1;
+}
+
+int flagged_move_unwrap(Negative<int> a) {
+    return std::move(a).unwrap() - 1;
+}
+
+int raw_move_unwrap(int a) {
+    return a - 1;
+}
+
+//------------------------------------------------------------------------------
+//returning
+
+Positive<int> flagged_return(Positive<int> a) {
+    return a;
+}
+
+int raw_return(int a) {
+    return a;
+}
+
+//------------------------------------------------------------------------------
+//conversions are checked at compile time only
+
+int flagged_conversion(BoundedInclusive<int, 1, 100> b) {
+    return NonNegative<int>(Positive<int>(b)).get();
+}
+
+int raw_conversion(int b) {
+    return b;
+}
+
+//------------------------------------------------------------------------------
+//arithmetic on bounded types with a representable interval needs no check
+
+int flagged_bounded_add(BoundedInclusive<int, 0, 100> a, BoundedInclusive<int, 0, 50> b) {
+    return (a + b).get();
+}
+
+int raw_bounded_add(int a, int b) {
+    return a + b;
+}
+
+int flagged_bounded_mul(BoundedInclusive<int, -10, 10> a, BoundedInclusive<int, 0, 50> b) {
+    return (a * b).get();
+}
+
+int raw_bounded_mul(int a, int b) {
+    return a * b;
+}
+
+//------------------------------------------------------------------------------
+//validation costs no more than the equivalent hand written check
+
+int flagged_positive_construct(int x) {
+    return Positive<int>(std::move(x)).get() * 3;
+}
+
+int raw_positive_construct(int x) {
+    if (x <= 0)
+        raw_fail();
+    return x * 3;
+}
+
+int flagged_bounded_construct(int x) {
+    return BoundedInclusive<int, 3, 7>(std::move(x)).get() * 3;
+}
+
+int raw_bounded_construct(int x) {
+    if (x < 3 || x > 7)
+        raw_fail();
+    return x * 3;
+}
+
+int* flagged_nonnull_construct(int* p) {
+    return NonNull<int*>(std::move(p)).get();
+}
+
+int* raw_nonnull_construct(int* p) {
+    if (!p)
+        raw_fail();
+    return p;
+}
+
@@ -0,0 +1,70 @@
+# compares the instruction counts of the flagged_X / raw_X function pairs within OBJECTS
+# usage: cmake -DOBJDUMP=<objdump> -DOBJECTS=<object files> -P compare_codegen.cmake
+
+if(NOT OBJDUMP OR NOT OBJECTS)
+    message(FATAL_ERROR "OBJDUMP and OBJECTS have to be defined")
+endif()
+
+set(failed FALSE)
+set(nPairs 0)
+
+foreach(object ${OBJECTS})
+    execute_process(
+        COMMAND ${OBJDUMP} -d -C --no-show-raw-insn ${object}
+        OUTPUT_VARIABLE disassembly
+        RESULT_VARIABLE result
+    )
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "${OBJDUMP} failed for ${object}")
+    endif()
+
+    string(REPLACE ";" "\;" disassembly "${disassembly}")
+    string(REPLACE "\n" ";" lines "${disassembly}")
+
+    set(current "")
+    set(functions "")
+    foreach(line ${lines})
+        if(line MATCHES "^[0-9a-f]+ <(.*)>:$")
+            set(symbol "${CMAKE_MATCH_1}")
+            # demangled, only the name before the parameter list is kept
+            # cold paths (e.g. throwing, "[clone .cold]") are split off by the compiler and ignored
+            if(symbol MATCHES "^((flagged|raw)_[A-Za-z0-9_]+)\\(.*\\)$")
+                set(current ${CMAKE_MATCH_1})
+                list(APPEND functions ${current})
+                set(count_${current} 0)
+            else()
+                set(current "")
+            endif()
+        elseif(current AND line MATCHES "^ +[0-9a-f]+:\t(.*)$")
+            set(instruction "${CMAKE_MATCH_1}")
+            # alignment padding
+            if(NOT instruction MATCHES "^(nop|xchg +%ax,%ax|data16|cs nop|int3)")
+                math(EXPR count_${current} "${count_${current}} + 1")
+            endif()
+        endif()
+    endforeach()
+
+    foreach(function ${functions})
+        if(function MATCHES "^flagged_(.*)$")
+            set(raw raw_${CMAKE_MATCH_1})
+            if(NOT DEFINED count_${raw})
+                message(SEND_ERROR "${function} has no ${raw} to compare against")
+                set(failed TRUE)
+            elseif(count_${function} GREATER count_${raw})
+                message(SEND_ERROR "${function}: ${count_${function}} instructions, ${raw}: ${count_${raw}}")
+                set(failed TRUE)
+            else()
+                message(STATUS "${function}: ${count_${function}} instructions, ${raw}: ${count_${raw}}")
+            endif()
+            math(EXPR nPairs "${nPairs} + 1")
+        endif()
+    endforeach()
+endforeach()
+
+if(nPairs EQUAL 0)
+    message(FATAL_ERROR "no flagged_X / raw_X pairs found")
+endif()
+
+if(failed)
+    message(FATAL_ERROR "flagged types add instructions")
+endif()
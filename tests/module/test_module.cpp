@@ -0,0 +1,49 @@
+/*
+    Copyright (c) 2016 Martin Buck
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+//uses flaggedT only via import, returns the number of failed checks
+//no Catch and no std includes, GCC 12 can't mix those with imported modules yet
+
+import flaggedT;
+
+using namespace flaggedT;
+
+int main() {
+    int failed = 0;
+
+    auto p = Positive<int>(3);
+    failed += p.get() != 3;
+
+    try {
+        Positive<int>(0);
+        ++failed;
+    } catch (FlaggedTError const& e) {
+        failed += e.kind() != FlagKind::Positive;
+        failed += e.violation() != Violation::TooSmall;
+    }
+
+    NonZero<int> nz = BoundedInclusive<int, 1, 5>(2);
+    failed += nz.get() != 2;
+
+    auto sum = BoundedInclusive<int, 0, 10>(4) + BoundedInclusive<int, 0, 10>(5);
+    failed += sum.get() != 9;
+
+    auto size = PowerOfTwo<unsigned>(8u);
+    failed += size.log2() != 3u || size.mod(13u) != 5u;
+
+    constexpr auto c = FlooredExclusive<int, 0>(7);
+    static_assert(Positive<int>(c).get() == 7, "constexpr conversion");
+
+    return failed;
+}
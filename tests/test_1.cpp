@@ -14,7 +14,16 @@
 #define CATCH_CONFIG_MAIN
 #include "../dependencies/Catch.h" //https://github.com/philsquared/Catch
 
+#include <array>
 #include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <string>
 #include <vector>
 
 #include "flaggedT.h"
@@ -45,12 +54,73 @@ int conversion_outer() {
     auto fi2 = FlooredInclusive<int,  1>(3); //could throw if passed number <  1
 
     //below can't compile, since fi1 not guarantee to be Positive
-    //return conversion_inner(fi1); //"Positive can only be constructed by a FlooredInclusive if MIN > 0"
+    //return conversion_inner(fi1); //[-1, inf) isn't within Positive's [1, inf)
 
     //below conversion from fi2 to Positive compiles and will never throw
     return conversion_inner(fi2);
 }
 
+//custom orders of Sorted and UniqueAndSorted
+struct Person {
+    string name;
+    int age;
+};
+
+struct by_age {
+    int const& operator()(Person const& p) const {
+        return p.age;
+    }
+};
+
+struct by_name_length { //computed key, sorted via cached keys
+    size_t operator()(Person const& p) const {
+        return p.name.size();
+    }
+};
+
+//wrappers must be as cheap to copy and pass as their inner type
+template <typename F, typename T>
+constexpr bool is_zero_cost() {
+    return sizeof(F) == sizeof(T)
+        && alignof(F) == alignof(T)
+        && is_trivially_copyable<F>::value
+        && is_trivially_destructible<F>::value
+        && is_standard_layout<F>::value;
+}
+
+static_assert(is_zero_cost<Immutable<int>, int>(), "Immutable<int> not zero cost");
+static_assert(is_zero_cost<NonNull<int*>, int*>(), "NonNull<int*> not zero cost");
+static_assert(is_zero_cost<NonZero<int>, int>(), "NonZero<int> not zero cost");
+static_assert(is_zero_cost<Positive<int>, int>(), "Positive<int> not zero cost");
+static_assert(is_zero_cost<PowerOfTwo<size_t>, size_t>(), "PowerOfTwo<size_t> not zero cost");
+static_assert(is_zero_cost<NonPositive<float>, float>(), "NonPositive<float> not zero cost");
+static_assert(is_zero_cost<Negative<double>, double>(), "Negative<double> not zero cost");
+static_assert(is_zero_cost<NonNegative<int64_t>, int64_t>(), "NonNegative<int64_t> not zero cost");
+static_assert(is_zero_cost<CeiledInclusive<int, 3>, int>(), "CeiledInclusive not zero cost");
+static_assert(is_zero_cost<CeiledExclusive<int, 3>, int>(), "CeiledExclusive not zero cost");
+static_assert(is_zero_cost<FlooredInclusive<int, 3>, int>(), "FlooredInclusive not zero cost");
+static_assert(is_zero_cost<FlooredExclusive<int, 3>, int>(), "FlooredExclusive not zero cost");
+static_assert(is_zero_cost<BoundedInclusive<double, 0, 1>, double>(), "BoundedInclusive not zero cost");
+static_assert(is_zero_cost<BoundedExclusive<double, 0, 1>, double>(), "BoundedExclusive not zero cost");
+static_assert(is_zero_cost<NonEmpty<array<int, 3>>, array<int, 3>>(), "NonEmpty<array> not zero cost");
+static_assert(is_zero_cost<FixedSized<array<int, 3>, 3>, array<int, 3>>(), "FixedSized<array> not zero cost");
+
+//conversions are allowed exactly if the source interval lies within the target interval
+static_assert(is_convertible<FlooredInclusive<int, 1>, Positive<int>>::value, "FlooredInclusive<1> -> Positive");
+static_assert(!is_convertible<FlooredInclusive<int, -1>, Positive<int>>::value, "FlooredInclusive<-1> -> Positive");
+static_assert(is_convertible<FlooredExclusive<int, 0>, FlooredInclusive<int, 1>>::value, "integral open bounds are closed bounds next to them");
+static_assert(!is_convertible<FlooredExclusive<double, 0>, FlooredInclusive<double, 1>>::value, "but not for floating point");
+static_assert(is_convertible<BoundedExclusive<double, -2, 0>, NonZero<double>>::value, "BoundedExclusive<-2, 0> excludes 0");
+static_assert(!is_convertible<BoundedInclusive<double, -2, 0>, NonZero<double>>::value, "BoundedInclusive<-2, 0> includes 0");
+static_assert(is_convertible<PowerOfTwo<int>, FlooredInclusive<int, 1>>::value, "PowerOfTwo -> FlooredInclusive<1>");
+static_assert(!is_convertible<Positive<int>, PowerOfTwo<int>>::value, "Positive -> PowerOfTwo");
+static_assert(!is_convertible<Positive<int>, Positive<long>>::value, "conversions keep the wrapped type");
+static_assert(!is_convertible<Negative<int>, NonNegative<int>>::value, "Negative -> NonNegative");
+static_assert(is_convertible<MoreThan<vector<int>, 0>, NonEmpty<vector<int>>>::value, "MoreThan<0> -> NonEmpty");
+static_assert(is_convertible<LessThan<vector<int>, 3>, FixedRangeInclusive<vector<int>, 0, 2>>::value, "LessThan<3> -> FixedRangeInclusive<0, 2>");
+static_assert(is_convertible<FixedRangeInclusive<vector<int>, 2, 2>, FixedSized<vector<int>, 2>>::value, "FixedRangeInclusive<2, 2> -> FixedSized<2>");
+static_assert(!is_convertible<NonEmpty<vector<int>>, Positive<vector<int>>>::value, "sizes and values don't mix");
+
 //examples (move these to example files) [also the example test case]
 
 TEST_CASE("FlaggedT") {
@@ -170,6 +240,33 @@ TEST_CASE("FlaggedT") {
         REQUIRE(be.get() == 0.3);
     }
 
+    SECTION("PowerOfTwo") {
+        REQUIRE_THROWS(PowerOfTwo<int>(0));
+        REQUIRE_THROWS(PowerOfTwo<int>(-4));
+        REQUIRE_THROWS(PowerOfTwo<int>(6));
+        REQUIRE_THROWS(PowerOfTwo<uint64_t>(3));
+
+        auto one = PowerOfTwo<int>(1);
+        REQUIRE(one.log2() == 0);
+
+        auto p = PowerOfTwo<uint64_t>(uint64_t(1) << 40);
+        REQUIRE(p.log2() == 40);
+
+        auto size = PowerOfTwo<size_t>(16);
+        REQUIRE(size.log2() == 4);
+        for (size_t x : { 0, 1, 15, 16, 17, 1000, 123456789 }) {
+            REQUIRE(size.mod(x) == x % 16);
+            REQUIRE(size.div(x) == x / 16);
+            REQUIRE(size.mul(x) == x * 16);
+        }
+
+        Positive<int> pos = PowerOfTwo<int>(8);
+        REQUIRE(pos.get() == 8);
+
+        NonZero<int> nz = PowerOfTwo<int>(8);
+        REQUIRE(nz.get() == 8);
+    }
+
     SECTION("NonPositive") {
         int ifail = 1;
         float ffail = 1.0f;
@@ -433,6 +530,198 @@ TEST_CASE("FlaggedT") {
         REQUIRE(bi.get() == 2);
     }
 
+    SECTION("BoundedArithmetic") {
+        auto a = BoundedInclusive<int, 0, 100>(70);
+        auto b = BoundedInclusive<int, 0, 50>(40);
+
+        auto sum = a + b;
+        static_assert(is_same<decltype(sum), BoundedInclusive<int, 0, 150>>::value, "wrong interval of +");
+        REQUIRE(sum.get() == 110);
+
+        auto diff = a - b;
+        static_assert(is_same<decltype(diff), BoundedInclusive<int, -50, 100>>::value, "wrong interval of -");
+        REQUIRE(diff.get() == 30);
+
+        auto prod = diff * BoundedInclusive<int, -2, 3>(-2);
+        static_assert(is_same<decltype(prod), BoundedInclusive<int, -200, 300>>::value, "wrong interval of *");
+        REQUIRE(prod.get() == -60);
+
+        auto neg = -a;
+        static_assert(is_same<decltype(neg), BoundedInclusive<int, -100, 0>>::value, "wrong interval of unary -");
+        REQUIRE(neg.get() == -70);
+
+        auto dsum = BoundedInclusive<double, 0, 1>(0.5) + BoundedInclusive<double, 0, 1>(0.25);
+        REQUIRE(dsum.get() == 0.75);
+
+        auto esum = BoundedExclusive<int, 0, 10>(5) + BoundedExclusive<int, -5, 0>(-1);
+        static_assert(is_same<decltype(esum), BoundedExclusive<int, -5, 10>>::value, "wrong interval of exclusive +");
+        REQUIRE(esum.get() == 4);
+
+        //floating point results are rounded and can reach an open bound, so they're checked like constructor arguments
+        using unit = BoundedExclusive<double, 0, 1>;
+        auto tiny = unit(1e-100) * unit(1e-100);
+        static_assert(is_same<decltype(tiny), unit>::value, "wrong interval of exclusive *");
+        REQUIRE(tiny.get() == 1e-200);
+        try {
+            unit(1e-200) * unit(1e-200); //underflows to 0
+            FAIL("no exception");
+        } catch (FlaggedTError const& e) {
+            REQUIRE(e.kind() == FlagKind::BoundedExclusive);
+            REQUIRE(e.violation() == Violation::TooSmall);
+            REQUIRE(e.value() == 0.0);
+        }
+        using unitf = BoundedExclusive<float, 0, 1>;
+        REQUIRE_THROWS(unitf(1e-30f) * unitf(1e-30f));
+
+        //result can be converted to any flag guaranteed by its interval
+        Positive<int> p = BoundedInclusive<int, 1, 2>(2) * BoundedInclusive<int, 3, 4>(3);
+        REQUIRE(p.get() == 6);
+
+        //interval doesn't fit the wrapped type, so the operation itself is checked
+        using small = BoundedInclusive<int8_t, 0, 100>;
+        auto fits = small(int8_t(20)) + small(int8_t(30));
+        REQUIRE(fits.get() == 50);
+        REQUIRE_THROWS(small(int8_t(100)) + small(int8_t(100)));
+
+        using u = BoundedInclusive<unsigned, 0, 10>;
+        REQUIRE_THROWS(u(3u) - u(5u));
+        REQUIRE((u(5u) - u(3u)).get() == 2u);
+    }
+
+    SECTION("ZeroCost") {
+        vector<Positive<int>> src;
+        for (int i = 1; i <= 100; ++i)
+            src.push_back(Positive<int>(move(i)));
+
+        //trivially copyable, so a plain memcpy is a valid copy
+        vector<int> raw(src.size());
+        memcpy(raw.data(), src.data(), src.size() * sizeof(Positive<int>));
+        REQUIRE(raw[0] == 1);
+        REQUIRE(raw[99] == 100);
+
+        auto dst = src;
+        memcpy(dst.data(), src.data() + 50, 50 * sizeof(Positive<int>));
+        REQUIRE(dst[0].get() == 51);
+    }
+
+    SECTION("FlaggedTError") {
+        try {
+            BoundedInclusive<int, 3, 5>(7);
+            FAIL("no exception");
+        } catch (FlaggedTError const& e) {
+            REQUIRE(e.kind() == FlagKind::BoundedInclusive);
+            REQUIRE(e.violation() == Violation::TooBig);
+            REQUIRE(e.value() == 7.0);
+            REQUIRE(e.bound() == 5.0);
+            REQUIRE(string(e.what()) == "Passed value to constructor of BoundedInclusive is too big");
+        }
+
+        try {
+            Positive<double>(-0.5);
+            FAIL("no exception");
+        } catch (FlaggedTError const& e) {
+            REQUIRE(e.kind() == FlagKind::Positive);
+            REQUIRE(e.violation() == Violation::TooSmall);
+            REQUIRE(e.value() == -0.5);
+            REQUIRE(e.bound() == 0.0);
+        }
+
+        try {
+            MoreThan<vector<int>, 3>(vector<int>({ 1, 2 }));
+            FAIL("no exception");
+        } catch (FlaggedTError const& e) {
+            REQUIRE(e.kind() == FlagKind::MoreThan);
+            REQUIRE(e.violation() == Violation::TooSmall);
+            REQUIRE(e.value() == 2.0);
+            REQUIRE(e.bound() == 3.0);
+        }
+
+        try {
+            int* null = nullptr;
+            NonNull<int*>(move(null));
+            FAIL("no exception");
+        } catch (FlaggedTError const& e) {
+            REQUIRE(e.kind() == FlagKind::NonNull);
+            REQUIRE(e.violation() == Violation::Null);
+            REQUIRE(std::isnan(e.value()));
+        }
+
+        try {
+            FlaggedArray<NonNegative<int>>(vector<int>({ 1, 2, -3, -4 }));
+            FAIL("no exception");
+        } catch (FlaggedTError const& e) {
+            REQUIRE(e.kind() == FlagKind::NonNegative);
+            REQUIRE(e.value() == -3.0);
+        }
+
+        try {
+            BoundedInclusive<int8_t, 0, 100>(int8_t(100)) + BoundedInclusive<int8_t, 0, 100>(int8_t(100));
+            FAIL("no exception");
+        } catch (FlaggedTError const& e) {
+            REQUIRE(e.kind() == FlagKind::BoundedInclusive);
+            REQUIRE(e.violation() == Violation::Overflow);
+        }
+    }
+
+    SECTION("constexpr") {
+        //validated at compile time, an invalid literal fails to compile
+        constexpr auto p = Positive<int>(3);
+        static_assert(p.get() == 3, "constexpr construction");
+
+        //constexpr auto wontCompile = Positive<int>(-3);
+
+        constexpr NonZero<int> nz = BoundedInclusive<int, 1, 5>(2);
+        static_assert(nz.get() == 2, "constexpr conversion");
+
+        constexpr auto sum = BoundedInclusive<int, 0, 10>(4) + BoundedInclusive<int, 0, 10>(5);
+        static_assert(sum.get() == 9, "constexpr arithmetic");
+
+        constexpr auto size = PowerOfTwo<unsigned>(8u);
+        static_assert(size.log2() == 3 && size.mod(13u) == 5u, "constexpr PowerOfTwo");
+
+        //usable as a non-type template argument and within read-only tables
+        array<int, p.get()> arr{};
+        REQUIRE(arr.size() == 3);
+
+        static constexpr Positive<int> table[] = { Positive<int>(1), Positive<int>(2), Positive<int>(4) };
+        REQUIRE(table[2].get() == 4);
+    }
+
+    SECTION("FlaggedArray") {
+        vector<float> raw(5000);
+        for (size_t i = 0; i < raw.size(); ++i)
+            raw[i] = 1.0f + i;
+        const float* buffer = raw.data();
+
+        auto arr = FlaggedArray<Positive<float>>(move(raw));
+        REQUIRE(arr.size() == 5000);
+        REQUIRE(arr[0].get() == 1.0f);
+        REQUIRE(arr.begin()->get() == 1.0f);
+        REQUIRE((arr.end() - 1)->get() == 5000.0f);
+
+        Positive<float> const& p = arr[42];
+        REQUIRE(p.get() == 43.0f);
+
+        //buffer is moved in and out without copying
+        vector<float> back = move(arr).unwrap();
+        REQUIRE(back.data() == buffer);
+
+        back[4321] = 0.0f;
+        REQUIRE_THROWS(FlaggedArray<Positive<float>>(move(back)));
+
+        REQUIRE_THROWS((FlaggedArray<BoundedInclusive<int, 0, 9>>(vector<int>({ 0, 5, 10 }))));
+        auto bi = FlaggedArray<BoundedInclusive<int, 0, 9>>(vector<int>({ 0, 5, 9 }));
+        int sum = 0;
+        for (auto const& x : bi)
+            sum += x;
+        REQUIRE(sum == 14);
+
+        auto fromFlags = FlaggedArray<Positive<int>>(vector<Positive<int>>({ Positive<int>(1), Positive<int>(2) }));
+        REQUIRE(fromFlags[1].get() == 2);
+
+        REQUIRE_THROWS(Positive<double>(nan("")));
+    }
+
     SECTION("NonEmpty") {
         using v = vector<int>;
         auto emptyVec = v();
@@ -534,6 +823,762 @@ TEST_CASE("FlaggedT") {
 
         auto sorted = Sorted<vector<int> >(move(unsorted));
         REQUIRE(is_sorted(sorted.get().begin(), sorted.get().end()));
+
+        auto descending = Sorted<vector<int>, greater<>>(vector<int>({ 1, 7, 8, 14, 3 }));
+        REQUIRE(descending.get() == vector<int>({ 14, 8, 7, 3, 1 }));
+
+        auto people = vector<Person>({ { "Bob", 42 }, { "Alexander", 7 }, { "Eve", 23 }, { "Christina", 64 }, { "Al", 7 } });
+
+        auto byAge = Sorted<vector<Person>, less<>, by_age>(vector<Person>(people));
+        REQUIRE(is_sorted(byAge.get().begin(), byAge.get().end(), [](Person const& a, Person const& b) { return a.age < b.age; }));
+        REQUIRE(byAge.get().back().name == "Christina");
+
+        auto byNameLength = Sorted<vector<Person>, greater<>, by_name_length>(vector<Person>(people));
+        REQUIRE(byNameLength.get().size() == people.size());
+        REQUIRE(is_sorted(byNameLength.get().begin(), byNameLength.get().end(), [](Person const& a, Person const& b) { return a.name.size() > b.name.size(); }));
+        REQUIRE(byNameLength.get().back().name == "Al");
+
+        vector<int> many(10000);
+        for (size_t i = 0; i < many.size(); ++i)
+            many[i] = static_cast<int>((i * 7919) % 10007);
+        struct negated {
+            int operator()(int x) const {
+                return -x;
+            }
+        };
+        auto permuted = Sorted<vector<int>, less<>, negated>(move(many));
+        REQUIRE(is_sorted(permuted.get().rbegin(), permuted.get().rend()));
+    }
+
+    SECTION("SortedCounting") {
+        mt19937 gen(42);
+        for (size_t n : { 0, 1, 10, 1000, 100000 }) {
+            vector<uint8_t> bytes(n);
+            vector<int16_t> shorts(n);
+            for (size_t i = 0; i < n; ++i) {
+                bytes[i] = static_cast<uint8_t>(gen());
+                shorts[i] = static_cast<int16_t>(gen());
+            }
+
+            auto sortedBytes = Sorted<vector<uint8_t>>(vector<uint8_t>(bytes));
+            sort(bytes.begin(), bytes.end());
+            REQUIRE(sortedBytes.get() == bytes);
+
+            auto descendingShorts = Sorted<vector<int16_t>, greater<>>(vector<int16_t>(shorts));
+            sort(shorts.begin(), shorts.end(), greater<int16_t>());
+            REQUIRE(descendingShorts.get() == shorts);
+
+            auto uniqueShorts = UniqueAndSorted<vector<int16_t>>(vector<int16_t>(shorts));
+            sort(shorts.begin(), shorts.end());
+            shorts.erase(unique(shorts.begin(), shorts.end()), shorts.end());
+            REQUIRE(uniqueShorts.get() == shorts);
+        }
+
+        //fixed size containers are counted in place, without erasing
+        array<uint8_t, 1000> fixedBytes;
+        for (auto& x : fixedBytes)
+            x = static_cast<uint8_t>(gen());
+        auto sortedFixed = Sorted<array<uint8_t, 1000>>(array<uint8_t, 1000>(fixedBytes));
+        sort(fixedBytes.begin(), fixedBytes.end());
+        REQUIRE(sortedFixed.get() == fixedBytes);
+        auto descendingFew = Sorted<array<uint8_t, 4>, greater<>>(array<uint8_t, 4>({ { 3, 200, 7, 3 } }));
+        REQUIRE((descendingFew.get() == array<uint8_t, 4>({ { 200, 7, 3, 3 } })));
+
+        using Level = BoundedInclusive<int, -50, 50>;
+        using Open = BoundedExclusive<int64_t, -3, 3>;
+        vector<Level> levels;
+        vector<Open> opens;
+        for (int i = 0; i < 1000; ++i) {
+            levels.push_back(Level(static_cast<int>(gen() % 101) - 50));
+            opens.push_back(Open(static_cast<int64_t>(gen() % 5) - 2));
+        }
+        auto sortedLevels = Sorted<vector<Level>>(move(levels));
+        REQUIRE(sortedLevels.get().size() == 1000);
+        REQUIRE(is_sorted(sortedLevels.get().begin(), sortedLevels.get().end()));
+        REQUIRE(sortedLevels.get().front().get() == -50);
+        REQUIRE(sortedLevels.get().back().get() == 50);
+
+        auto uniqueOpens = UniqueAndSorted<vector<Open>, greater<>>(move(opens));
+        REQUIRE(uniqueOpens.get().size() == 5);
+        REQUIRE(uniqueOpens.get().front().get() == 2);
+        REQUIRE(uniqueOpens.get().back().get() == -2);
+    }
+
+    SECTION("UniqueAndSortedHashed") {
+        mt19937_64 gen(3);
+        for (size_t n : { 1000, 1024, 5000, 100000 }) {
+            for (uint64_t distinct : { uint64_t(1), uint64_t(10), uint64_t(n / 10), uint64_t(n * 100) }) {
+                vector<int64_t> raw(n);
+                for (auto& x : raw)
+                    x = static_cast<int64_t>(gen() % distinct) - static_cast<int64_t>(distinct / 2);
+
+                auto expected = raw;
+                sort(expected.begin(), expected.end());
+                expected.erase(unique(expected.begin(), expected.end()), expected.end());
+                REQUIRE(UniqueAndSorted<vector<int64_t>>(vector<int64_t>(raw)).get() == expected);
+
+                reverse(expected.begin(), expected.end());
+                REQUIRE((UniqueAndSorted<vector<int64_t>, greater<>>(vector<int64_t>(raw)).get() == expected));
+            }
+        }
+
+        //duplicates in the first sixteenth only, the rest is unique
+        vector<uint32_t> late(16000, 7);
+        for (size_t i = 1000; i < late.size(); ++i)
+            late[i] = static_cast<uint32_t>(i);
+        auto lateUnique = UniqueAndSorted<vector<uint32_t>>(move(late));
+        REQUIRE(lateUnique.get().size() == 15001);
+        REQUIRE(lateUnique.get().front() == 7);
+
+        vector<Person> people;
+        for (int i = 0; i < 3000; ++i)
+            people.push_back(Person{ to_string(i), i % 70 });
+        auto byAge = UniqueAndSorted<vector<Person>, less<>, by_age>(move(people));
+        REQUIRE(byAge.get().size() == 70);
+        for (int age = 0; age < 70; ++age) {
+            REQUIRE(byAge.get()[static_cast<size_t>(age)].age == age);
+            REQUIRE((stoi(byAge.get()[static_cast<size_t>(age)].name) % 70 == age));
+        }
+    }
+
+    SECTION("SortedSearch") {
+        mt19937 gen(7);
+        for (size_t n : { 0, 1, 2, 15, 16, 17, 33, 100, 1000, 10000 }) {
+            uniform_int_distribution<int> dist(0, static_cast<int>(n / 2));
+            vector<int> raw(n);
+            for (auto& x : raw)
+                x = dist(gen);
+
+            auto sorted = Sorted<vector<int>>(vector<int>(raw));
+            auto unique = UniqueAndSorted<vector<int>>(vector<int>(raw));
+            vector<int> const& s = sorted.get();
+            vector<int> const& u = unique.get();
+
+            vector<int> keys;
+            for (int key = -1; key <= static_cast<int>(n / 2) + 1; ++key)
+                keys.push_back(key);
+
+            for (int key : keys) {
+                REQUIRE(sorted.lower_bound(key) == lower_bound(s.begin(), s.end(), key));
+                REQUIRE(sorted.upper_bound(key) == upper_bound(s.begin(), s.end(), key));
+                REQUIRE(sorted.equal_range(key) == equal_range(s.begin(), s.end(), key));
+                REQUIRE(sorted.contains(key) == binary_search(s.begin(), s.end(), key));
+                REQUIRE(unique.lower_bound(key) == lower_bound(u.begin(), u.end(), key));
+                REQUIRE(unique.contains(key) == binary_search(u.begin(), u.end(), key));
+            }
+
+            shuffle(keys.begin(), keys.end(), gen);
+            vector<size_t> ranks;
+            sorted.ranks(keys.begin(), keys.end(), back_inserter(ranks));
+            REQUIRE(ranks.size() == keys.size());
+            for (size_t i = 0; i < keys.size(); ++i)
+                REQUIRE(ranks[i] == sorted.rank(keys[i]));
+        }
+
+        auto descending = Sorted<vector<int>, greater<>>(vector<int>({ 1, 9, 4, 7, 4 }));
+        REQUIRE(descending.rank(4) == 2);
+        REQUIRE((descending.upper_bound(4) - descending.get().begin()) == 4);
+
+        auto byAge = UniqueAndSorted<vector<Person>, less<>, by_age>(vector<Person>({ { "Bob", 42 }, { "Eve", 23 } }));
+        REQUIRE(byAge.contains(23));
+        REQUIRE(!byAge.contains(24));
+        REQUIRE(byAge.upper_bound(23)->name == "Bob");
+    }
+
+    SECTION("SortedIndex") {
+        mt19937 gen(42);
+        for (size_t n : { 0, 1, 2, 3, 7, 8, 100, 1000, 10000 }) {
+            uniform_int_distribution<int> dist(0, static_cast<int>(n));
+            vector<int> raw(n);
+            for (auto& x : raw)
+                x = dist(gen);
+
+            auto index = SortedIndex<vector<int>>(vector<int>(raw));
+            sort(raw.begin(), raw.end());
+            REQUIRE(index.get() == raw);
+            REQUIRE(index.size() == n);
+
+            for (int key = -1; key <= static_cast<int>(n) + 1; ++key) {
+                const auto expected = lower_bound(raw.begin(), raw.end(), key);
+                REQUIRE(index.rank(key) == static_cast<size_t>(expected - raw.begin()));
+                REQUIRE((index.lower_bound(key) - index.get().begin()) == (expected - raw.begin()));
+                REQUIRE(index.contains(key) == binary_search(raw.begin(), raw.end(), key));
+            }
+        }
+
+        auto descending = SortedIndex<vector<int>, greater<>>(Sorted<vector<int>, greater<>>(vector<int>({ 1, 9, 4, 7 })));
+        REQUIRE(descending.rank(8) == 1);
+        REQUIRE(descending.contains(4));
+        REQUIRE(!descending.contains(5));
+
+        Sorted<vector<int>, greater<>> const& sorted = descending;
+        REQUIRE(sorted.get().front() == 9);
+
+        auto byAge = SortedIndex<vector<Person>, less<>, by_age>(vector<Person>({ { "Bob", 42 }, { "Eve", 23 } }));
+        REQUIRE(byAge.lower_bound(30)->name == "Bob");
+    }
+
+    SECTION("LearnedIndex") {
+        mt19937_64 gen(42);
+        for (size_t n : { 0, 1, 2, 3, 7, 100, 1000, 100000 }) {
+            //a mix of dense runs, duplicates and large gaps, to get many lines and wrong predictions
+            uniform_int_distribution<int64_t> gap(0, 3);
+            uniform_int_distribution<int64_t> jump(0, int64_t(1) << 40);
+            vector<int64_t> raw(n);
+            int64_t current = -(int64_t(1) << 50);
+            for (auto& x : raw) {
+                current += gen() % 64 == 0 ? jump(gen) : gap(gen);
+                x = current;
+            }
+            shuffle(raw.begin(), raw.end(), gen);
+
+            auto index = LearnedIndex<vector<int64_t>, 8>(vector<int64_t>(raw));
+            sort(raw.begin(), raw.end());
+            REQUIRE(index.get() == raw);
+            REQUIRE(index.segments() <= n + 1);
+
+            vector<int64_t> keys(raw);
+            for (size_t i = 0; i < 1000; ++i)
+                keys.push_back(static_cast<int64_t>(gen()));
+            keys.push_back(numeric_limits<int64_t>::min());
+            keys.push_back(numeric_limits<int64_t>::max());
+            for (auto key : vector<int64_t>(keys)) {
+                if (key != numeric_limits<int64_t>::min())
+                    keys.push_back(key - 1);
+                if (key != numeric_limits<int64_t>::max())
+                    keys.push_back(key + 1);
+            }
+
+            for (auto key : keys) {
+                const auto expected = lower_bound(raw.begin(), raw.end(), key);
+                REQUIRE(index.rank(key) == static_cast<size_t>(expected - raw.begin()));
+                REQUIRE(index.contains(key) == binary_search(raw.begin(), raw.end(), key));
+            }
+        }
+
+        vector<double> linear(10000);
+        for (size_t i = 0; i < linear.size(); ++i)
+            linear[i] = 0.5 * static_cast<double>(i);
+        auto floating = LearnedIndex<vector<double>>(vector<double>(linear));
+        REQUIRE(floating.segments() == 1);
+        REQUIRE(floating.rank(100.25) == 201);
+        REQUIRE(floating.contains(4999.5));
+        REQUIRE(!floating.contains(5000.0));
+
+        REQUIRE(floating.rank(numeric_limits<double>::infinity()) == linear.size());
+        REQUIRE(floating.rank(-numeric_limits<double>::infinity()) == 0);
+        REQUIRE(floating.rank(numeric_limits<double>::quiet_NaN()) == 0); //no element is smaller than NaN
+
+        //100 duplicates of each key, so the lines rise by 100 positions per key and keys far past the last one predict past any size_t
+        vector<uint64_t> duplicates;
+        for (uint64_t key = 0; key < 100; ++key)
+            duplicates.insert(duplicates.end(), 100, key);
+        auto steep = LearnedIndex<vector<uint64_t>, 8>(vector<uint64_t>(duplicates));
+        for (uint64_t key : { uint64_t(0), uint64_t(50), uint64_t(99), uint64_t(100), uint64_t(1) << 40, numeric_limits<uint64_t>::max() - 1, numeric_limits<uint64_t>::max() })
+            REQUIRE(steep.rank(key) == static_cast<size_t>(lower_bound(duplicates.begin(), duplicates.end(), key) - duplicates.begin()));
+        REQUIRE(!steep.contains(numeric_limits<uint64_t>::max()));
+
+        auto byAge = LearnedIndex<vector<Person>, 64, by_age>(vector<Person>({ { "Bob", 42 }, { "Eve", 23 } }));
+        REQUIRE(byAge.lower_bound(30)->name == "Bob");
+    }
+
+    SECTION("CompressedSortedSet") {
+        mt19937_64 gen(42);
+        for (size_t n : { 0, 1, 2, 300, 10000 }) {
+            for (uint64_t range : { uint64_t(10), uint64_t(100000), uint64_t(1) << 40, numeric_limits<uint64_t>::max() }) {
+                vector<uint64_t> raw(n);
+                for (auto& x : raw)
+                    x = range == numeric_limits<uint64_t>::max() ? gen() : gen() % range;
+
+                auto set = UniqueAndSorted<vector<uint64_t>>(move(raw));
+                vector<uint64_t> const& expected = set.get();
+                auto compressed = CompressedSortedSet<uint64_t>(set);
+                REQUIRE(compressed.size() == expected.size());
+                REQUIRE(compressed.decompress().get() == expected);
+                REQUIRE(vector<uint64_t>(compressed.begin(), compressed.end()) == expected);
+
+                for (size_t i = 0; i < expected.size(); ++i)
+                    REQUIRE(compressed[i] == expected[i]);
+
+                vector<uint64_t> keys({ 0, numeric_limits<uint64_t>::max() });
+                for (auto x : expected) {
+                    keys.push_back(x);
+                    keys.push_back(x + 1);
+                    keys.push_back(x - 1);
+                }
+                for (size_t i = 0; i < 1000; ++i)
+                    keys.push_back(gen() % range);
+
+                for (auto key : keys) {
+                    const auto lower = lower_bound(expected.begin(), expected.end(), key);
+                    REQUIRE(compressed.rank(key) == static_cast<size_t>(lower - expected.begin()));
+                    REQUIRE(compressed.contains(key) == binary_search(expected.begin(), expected.end(), key));
+                }
+            }
+        }
+
+        vector<uint32_t> evens, triples;
+        for (uint32_t i = 0; i < 100000; i += 2)
+            evens.push_back(i);
+        for (uint32_t i = 0; i < 100000; i += 3)
+            triples.push_back(i * 7 % 100003);
+        auto a = CompressedSortedSet<uint32_t>(UniqueAndSorted<vector<uint32_t>>(vector<uint32_t>(evens)));
+        auto b = CompressedSortedSet<uint32_t>(UniqueAndSorted<vector<uint32_t>>(vector<uint32_t>(triples)));
+        REQUIRE(a.bytes() < evens.size() * sizeof(uint32_t) / 4);
+
+        vector<uint32_t> expected;
+        auto sortedTriples = UniqueAndSorted<vector<uint32_t>>(move(triples)).get();
+        set_intersection(evens.begin(), evens.end(), sortedTriples.begin(), sortedTriples.end(), back_inserter(expected));
+        REQUIRE(intersection(a, b).get() == expected);
+        REQUIRE(intersection(b, a).get() == expected);
+
+        auto it = a.begin();
+        it.skip_to(1001);
+        REQUIRE(*it == 1002);
+        it.skip_to(50001);
+        REQUIRE(*it == 50002);
+        it.skip_to(100000);
+        REQUIRE(it == a.end());
+    }
+
+    SECTION("RoaringBitmap") {
+        mt19937_64 gen(42);
+        //chunks of each kind: sparse (array), dense (bitmap) and consecutive (run), some only within one of the sets
+        auto random_set = [&gen](uint32_t stride) {
+            vector<uint32_t> result({ 0, numeric_limits<uint32_t>::max() });
+            for (uint32_t chunk = 0; chunk < 12; ++chunk) {
+                const uint32_t first = chunk * stride << 16;
+                switch (gen() % 4) {
+                case 0:
+                    for (int i = 0; i < 100; ++i)
+                        result.push_back(first + static_cast<uint32_t>(gen() % 65536));
+                    break;
+                case 1:
+                    for (int i = 0; i < 30000; ++i)
+                        result.push_back(first + static_cast<uint32_t>(gen() % 65536));
+                    break;
+                case 2:
+                    for (uint32_t i = 0; i < 5000; ++i)
+                        result.push_back(first + 60000 - i);
+                    break;
+                }
+            }
+            return UniqueAndSorted<vector<uint32_t>>(move(result));
+        };
+
+        for (int round = 0; round < 10; ++round) {
+            const auto a = random_set(1);
+            const auto b = random_set(round % 2 + 1);
+            vector<uint32_t> const& rawA = a.get();
+            vector<uint32_t> const& rawB = b.get();
+            const auto roaringA = RoaringBitmap(a);
+            const auto roaringB = RoaringBitmap(b);
+
+            REQUIRE(roaringA.size() == rawA.size());
+            REQUIRE(roaringA.decompress().get() == rawA);
+
+            for (int i = 0; i < 1000; ++i) {
+                const uint32_t inside = rawA[gen() % rawA.size()];
+                const auto random = static_cast<uint32_t>(gen() % (12 << 16));
+                REQUIRE(roaringA.contains(inside));
+                REQUIRE(roaringA.contains(random) == binary_search(rawA.begin(), rawA.end(), random));
+            }
+
+            vector<uint32_t> both, either;
+            set_intersection(rawA.begin(), rawA.end(), rawB.begin(), rawB.end(), back_inserter(both));
+            set_union(rawA.begin(), rawA.end(), rawB.begin(), rawB.end(), back_inserter(either));
+            REQUIRE((roaringA & roaringB).decompress().get() == both);
+            REQUIRE((roaringA | roaringB).decompress().get() == either);
+            REQUIRE((roaringA & roaringB).size() == both.size());
+        }
+
+        vector<uint32_t> range(1000000);
+        iota(range.begin(), range.end(), 7u);
+        const auto runs = RoaringBitmap(UniqueAndSorted<vector<uint32_t>>(move(range)));
+        REQUIRE(runs.size() == 1000000);
+        REQUIRE(runs.bytes() < 4096);
+        REQUIRE(runs.contains(7));
+        REQUIRE(runs.contains(1000006));
+        REQUIRE(!runs.contains(6));
+        REQUIRE(!runs.contains(1000007));
+    }
+
+    SECTION("BoundedSet") {
+        using Digit = BoundedInclusive<int, -5, 194>;
+        static_assert(sizeof(BoundedSet<int, -5, 194>) == 4 * sizeof(uint64_t), "200 values take 4 words");
+
+        auto set = BoundedSet<int, -5, 194>();
+        REQUIRE(set.empty());
+        REQUIRE(set.insert(Digit(-5)));
+        REQUIRE(set.insert(Digit(194)));
+        REQUIRE(set.insert(Digit(63)));
+        REQUIRE(!set.insert(Digit(63)));
+        REQUIRE(set.size() == 3);
+        REQUIRE(set.contains(Digit(-5)));
+        REQUIRE(set.contains(Digit(194)));
+        REQUIRE(!set.contains(Digit(0)));
+        REQUIRE(set.erase(Digit(63)));
+        REQUIRE(!set.erase(Digit(63)));
+        REQUIRE(set.size() == 2);
+
+        mt19937 gen(42);
+        uniform_int_distribution<int> dist(-5, 194);
+        vector<Digit> raw;
+        for (int i = 0; i < 150; ++i)
+            raw.push_back(Digit(dist(gen)));
+
+        auto unique = Unique<vector<Digit>>(vector<Digit>(raw));
+        auto uniqueAndSorted = UniqueAndSorted<vector<Digit>>(vector<Digit>(raw));
+        auto fromUnique = BoundedSet<int, -5, 194>(unique);
+        auto fromSorted = BoundedSet<int, -5, 194>(uniqueAndSorted);
+        REQUIRE(fromUnique == fromSorted);
+        REQUIRE(fromSorted.size() == uniqueAndSorted.get().size());
+
+        vector<int> expected, decompressed;
+        for (auto const& x : uniqueAndSorted.get())
+            expected.push_back(x);
+        const auto roundTrip = fromSorted.decompress();
+        for (auto const& x : roundTrip.get())
+            decompressed.push_back(x);
+        REQUIRE(decompressed == expected);
+
+        auto both = fromSorted & set;
+        auto either = fromSorted | set;
+        REQUIRE(both.size() == static_cast<size_t>(fromSorted.contains(Digit(-5)) + fromSorted.contains(Digit(194))));
+        REQUIRE(either.size() == fromSorted.size() + 2 - both.size());
+        REQUIRE(either.contains(Digit(-5)));
+        either.clear();
+        REQUIRE(either.empty());
+    }
+
+    SECTION("BloomFiltered") {
+        using Filtered = BloomFiltered<vector<uint64_t>>;
+
+        auto empty = Filtered(vector<uint64_t>());
+        REQUIRE(!empty.contains(0));
+        REQUIRE(empty.bytes() > 0);
+
+        mt19937_64 gen(11);
+        vector<uint64_t> raw(20000);
+        for (auto& x : raw)
+            x = gen() % 1000000;
+
+        auto filtered = Filtered(vector<uint64_t>(raw), Filtered::rate(0.01));
+        auto plain = UniqueAndSorted<vector<uint64_t>>(vector<uint64_t>(raw));
+        REQUIRE(filtered.get() == plain.get());
+        for (auto x : raw)
+            REQUIRE(filtered.might_contain(x));
+
+        size_t falsePositives = 0;
+        for (uint64_t x = 0; x < 1000000; ++x) {
+            REQUIRE(filtered.contains(x) == plain.contains(x));
+            falsePositives += filtered.might_contain(x) && !plain.contains(x);
+        }
+        REQUIRE((falsePositives < 2 * 10000)); //1% of about 10^6 missing keys, twice as a margin
+
+        //copies own buffers of their own, the filter mustn't depend on where they're allocated
+        for (int trial = 0; trial < 8; ++trial) {
+            vector<char> shift(static_cast<size_t>(8 * trial)); //varies the addresses of the following allocations
+            const auto copied = filtered;
+            auto assigned = Filtered(vector<uint64_t>({ 1 }));
+            assigned = filtered;
+            for (auto x : raw) {
+                REQUIRE(copied.contains(x));
+                REQUIRE(assigned.contains(x));
+            }
+            REQUIRE(copied.bytes() == filtered.bytes());
+        }
+
+        auto coarse = Filtered(move(plain), Filtered::rate(0.2));
+        REQUIRE(coarse.bytes() < filtered.bytes());
+
+        REQUIRE_THROWS(Filtered(vector<uint64_t>(), Filtered::rate(1.0)));
+
+        vector<string> words({ "b", "a", "c", "a" });
+        auto byWord = BloomFiltered<vector<string>, greater<>>(Unique<vector<string>>(move(words)));
+        REQUIRE(byWord.get().size() == 3);
+        REQUIRE(byWord.get().front() == "c");
+        REQUIRE(byWord.contains("a"));
+        REQUIRE(!byWord.contains("d"));
+
+        vector<Person> people({ { "Ann", 30 }, { "Bob", 20 }, { "Cid", 30 } });
+        auto byAge = BloomFiltered<vector<Person>, less<>, by_age>(move(people));
+        REQUIRE(byAge.get().size() == 2);
+        REQUIRE(byAge.contains(20));
+        REQUIRE(!byAge.contains(25));
+    }
+
+    SECTION("SortedStreamBuilder") {
+        mt19937 gen(5);
+        for (size_t n : { 0, 1, 100, 1000, 5000 }) {
+            vector<int> raw(n);
+            for (auto& x : raw)
+                x = static_cast<int>(gen() % 1000) - 500;
+
+            //64 bytes of memory, 16 ints per run, so 5000 elements take multiple merge passes
+            auto builder = SortedStreamBuilder<int>(".", 64);
+            builder.push(raw.begin(), raw.end());
+            REQUIRE(builder.size() == n);
+            REQUIRE(builder.spilled_runs() == n / 16);
+
+            const auto file = builder.finish("flaggedT_test_sorted");
+            REQUIRE(builder.size() == 0);
+            REQUIRE(builder.spilled_runs() == 0);
+            REQUIRE(file.size() == n);
+            REQUIRE(file.empty() == (n == 0));
+
+            sort(raw.begin(), raw.end());
+            REQUIRE(vector<int>(file.begin(), file.end()) == raw);
+            REQUIRE(file.load().get() == raw);
+            REQUIRE(remove(file.path().c_str()) == 0);
+        }
+
+        struct Entry {
+            int key;
+            double value;
+        };
+        struct by_key {
+            int const& operator()(Entry const& e) const {
+                return e.key;
+            }
+        };
+
+        //each key once, as 7919 and 1000 are coprime
+        auto builder = SortedStreamBuilder<Entry, greater<>, by_key>(".", 100 * sizeof(Entry));
+        vector<double> values(1000);
+        for (int i = 0; i < 1000; ++i) {
+            builder.push(Entry{ (i * 7919) % 1000, i * 0.5 });
+            values[static_cast<size_t>((i * 7919) % 1000)] = i * 0.5;
+        }
+        REQUIRE(builder.spilled_runs() == 10);
+        auto descending = builder.finish("flaggedT_test_descending");
+        int expected = 999;
+        for (auto const& e : descending) {
+            REQUIRE(e.key == expected);
+            REQUIRE(e.value == values[static_cast<size_t>(expected)]);
+            --expected;
+        }
+        REQUIRE(expected == -1);
+        REQUIRE(remove(descending.path().c_str()) == 0);
+
+        //the buffer takes the memory passed at once instead of growing past it
+        for (size_t memory : { sizeof(int), 10 * sizeof(int) + 3, size_t(4096) }) {
+            auto bounded = SortedStreamBuilder<int>(".", memory);
+            REQUIRE(bounded.memory_bytes() == 0);
+            for (int round = 0; round < 2; ++round) {
+                for (int i = 0; i < 3000; ++i) {
+                    bounded.push(i * 7919 % 3000);
+                    REQUIRE(bounded.memory_bytes() <= memory);
+                }
+                const auto file = bounded.finish("flaggedT_test_bounded");
+                REQUIRE(bounded.memory_bytes() == 0);
+                REQUIRE(file.size() == 3000);
+                REQUIRE(remove(file.path().c_str()) == 0);
+            }
+        }
+
+        auto missing = SortedStreamBuilder<int>("flaggedT_missing_directory", sizeof(int));
+        REQUIRE_THROWS(missing.push(1));
+    }
+
+    SECTION("SortedView") {
+        mt19937 gen(6);
+        vector<int> raw(3000);
+        for (auto& x : raw)
+            x = static_cast<int>(gen() % 1000);
+        const auto sorted = Sorted<vector<int>>(vector<int>(raw));
+        save(sorted, "flaggedT_test_view");
+
+        for (auto verification : { Verification::Order, Verification::Checksum, Verification::Trusted }) {
+            auto view = SortedView<int>("flaggedT_test_view", verification);
+            REQUIRE(view.size() == 3000);
+            REQUIRE(vector<int>(view.begin(), view.end()) == sorted.get());
+            for (int key : { -1, 0, 17, 500, 999, 1000 }) {
+                REQUIRE(view.rank(key) == sorted.rank(key));
+                REQUIRE(distance(view.begin(), view.lower_bound(key)) == distance(sorted.get().begin(), sorted.lower_bound(key)));
+                REQUIRE(distance(view.begin(), view.upper_bound(key)) == distance(sorted.get().begin(), sorted.upper_bound(key)));
+                REQUIRE(view.contains(key) == sorted.contains(key));
+            }
+            vector<int> keys({ 5, -3, 700, 2000 });
+            vector<size_t> ranks(keys.size());
+            view.ranks(keys.begin(), keys.end(), ranks.begin());
+            for (size_t i = 0; i < keys.size(); ++i)
+                REQUIRE(ranks[i] == sorted.rank(keys[i]));
+        }
+
+        //the mapping outlives the view it was copied from
+        auto copy = [] {
+            auto view = SortedView<int>("flaggedT_test_view");
+            return view;
+        }();
+        REQUIRE(copy[0] == sorted.get()[0]);
+
+        //sorted, but not unique
+        try {
+            UniqueAndSortedView<int>("flaggedT_test_view");
+            FAIL("no exception");
+        } catch (FlaggedTError const& e) {
+            REQUIRE(e.kind() == FlagKind::UniqueAndSorted);
+            REQUIRE(e.violation() == Violation::Duplicate);
+        }
+        try {
+            UniqueAndSortedView<int>("flaggedT_test_view", Verification::Trusted);
+            FAIL("no exception");
+        } catch (FlaggedTError const& e) {
+            REQUIRE(e.violation() == Violation::Duplicate);
+        }
+        REQUIRE_THROWS(SortedView<int64_t>("flaggedT_test_view"));
+        REQUIRE_THROWS(SortedView<int>("flaggedT_missing_view"));
+
+        //swap the first and the last element, only the checksum or the order reveal it
+        {
+            FILE* f = fopen("flaggedT_test_view", "r+b");
+            REQUIRE(f);
+            const int first = sorted.get().front();
+            const int last = sorted.get().back();
+            REQUIRE(fseek(f, 64, SEEK_SET) == 0);
+            REQUIRE(fwrite(&last, sizeof(int), 1, f) == 1);
+            REQUIRE(fseek(f, 64 + 2999 * static_cast<long>(sizeof(int)), SEEK_SET) == 0);
+            REQUIRE(fwrite(&first, sizeof(int), 1, f) == 1);
+            REQUIRE(fclose(f) == 0);
+        }
+        REQUIRE_THROWS(SortedView<int>("flaggedT_test_view", Verification::Checksum));
+        REQUIRE(SortedView<int>("flaggedT_test_view", Verification::Trusted).size() == 3000);
+        try {
+            SortedView<int>("flaggedT_test_view");
+            FAIL("no exception");
+        } catch (FlaggedTError const& e) {
+            REQUIRE(e.kind() == FlagKind::Sorted);
+            REQUIRE(e.violation() == Violation::NotSorted);
+            REQUIRE(e.value() == 1.0);
+        }
+        REQUIRE(remove("flaggedT_test_view") == 0);
+
+        auto unique = UniqueAndSorted<vector<int>, greater<>>(move(raw));
+        save(unique, "flaggedT_test_unique");
+        for (auto verification : { Verification::Order, Verification::Checksum, Verification::Trusted }) {
+            auto view = UniqueAndSortedView<int, greater<>>("flaggedT_test_unique", verification);
+            REQUIRE(vector<int>(view.begin(), view.end()) == unique.get());
+            REQUIRE(view.contains(999) == unique.contains(999));
+            REQUIRE(view.rank(500) == unique.rank(500));
+        }
+        //the order is only checked against Compare
+        REQUIRE_THROWS(SortedView<int>("flaggedT_test_unique"));
+        REQUIRE(remove("flaggedT_test_unique") == 0);
+
+        auto builder = SortedStreamBuilder<int>(".", 64);
+        for (int i = 100; i > 0; --i)
+            builder.push(i % 10);
+        const auto file = builder.finish("flaggedT_test_built");
+        auto built = SortedView<int>(file);
+        REQUIRE(built.size() == 100);
+        REQUIRE(built.rank(5) == 50);
+        const auto fives = built.equal_range(5);
+        REQUIRE(distance(fives.first, fives.second) == 10);
+        REQUIRE(SortedView<int>(file.path(), Verification::Checksum).size() == 100);
+        REQUIRE(remove(file.path().c_str()) == 0);
+
+        save(Sorted<vector<int>>(vector<int>()), "flaggedT_test_empty");
+        auto empty = SortedView<int>("flaggedT_test_empty", Verification::Checksum);
+        REQUIRE(empty.empty());
+        //verifying the order doesn't rely on the flags of the header
+        REQUIRE(UniqueAndSortedView<int>("flaggedT_test_empty").empty());
+        REQUIRE(!empty.contains(1));
+        REQUIRE(remove("flaggedT_test_empty") == 0);
+    }
+
+    SECTION("save / load") {
+        auto overwrite = [](string const& path, size_t index, int value) {
+            FILE* f = fopen(path.c_str(), "r+b");
+            REQUIRE(f);
+            REQUIRE(fseek(f, 64 + static_cast<long>(index * sizeof(int)), SEEK_SET) == 0);
+            REQUIRE(fwrite(&value, sizeof(int), 1, f) == 1);
+            REQUIRE(fclose(f) == 0);
+        };
+        const auto all = { Verification::Order, Verification::Checksum, Verification::Trusted };
+
+        mt19937 gen(7);
+        vector<int> raw(1000);
+        for (auto& x : raw)
+            x = static_cast<int>(gen() % 100);
+        const auto sorted = Sorted<vector<int>>(vector<int>(raw));
+        save(sorted, "flaggedT_test_sorted");
+        for (auto verification : all) {
+            REQUIRE(load<Sorted<vector<int>>>("flaggedT_test_sorted", verification).get() == sorted.get());
+            REQUIRE((load<UniqueAndSorted<vector<int>>>("flaggedT_test_sorted", verification).get() == UniqueAndSorted<vector<int>>(vector<int>(raw)).get()));
+            auto fromDeque = load<Sorted<deque<int>>>("flaggedT_test_sorted", verification);
+            REQUIRE(equal(fromDeque.get().begin(), fromDeque.get().end(), sorted.get().begin(), sorted.get().end()));
+        }
+
+        //unsorted elements within a file which records them as sorted: only trusting its header keeps them
+        overwrite("flaggedT_test_sorted", 0, 1000);
+        REQUIRE(load<Sorted<vector<int>>>("flaggedT_test_sorted", Verification::Trusted).get()[0] == 1000);
+        REQUIRE_THROWS(load<Sorted<vector<int>>>("flaggedT_test_sorted", Verification::Checksum));
+        const auto resorted = load<Sorted<vector<int>>>("flaggedT_test_sorted");
+        REQUIRE(is_sorted(resorted.get().begin(), resorted.get().end()));
+        REQUIRE(resorted.get().back() == 1000);
+        REQUIRE_THROWS(load<Sorted<vector<int64_t>>>("flaggedT_test_sorted"));
+        REQUIRE_THROWS(load<Sorted<vector<int>>>("flaggedT_missing_file"));
+        REQUIRE(remove("flaggedT_test_sorted") == 0);
+
+        //the header of Unique doesn't record the order
+        save(Unique<vector<int>>(vector<int>({ 3, 3, 1, 2, 2, 3 })), "flaggedT_test_unique");
+        for (auto verification : all) {
+            REQUIRE(load<Unique<vector<int>>>("flaggedT_test_unique", verification).get() == vector<int>({ 3, 1, 2, 3 }));
+            REQUIRE(load<Sorted<vector<int>>>("flaggedT_test_unique", verification).get() == vector<int>({ 1, 2, 3, 3 }));
+            REQUIRE((load<UniqueAndSorted<vector<int>, greater<>>>("flaggedT_test_unique", verification).get() == vector<int>({ 3, 2, 1 })));
+        }
+        REQUIRE(remove("flaggedT_test_unique") == 0);
+
+        save(FlaggedArray<Positive<int>>(vector<int>({ 1, 2, 3 })), "flaggedT_test_positive");
+        for (auto verification : all)
+            REQUIRE(load<FlaggedArray<Positive<int>>>("flaggedT_test_positive", verification)[2].get() == 3);
+        overwrite("flaggedT_test_positive", 1, -2);
+        REQUIRE(load<FlaggedArray<Positive<int>>>("flaggedT_test_positive", Verification::Trusted)[1].get() == -2);
+        try {
+            load<FlaggedArray<Positive<int>>>("flaggedT_test_positive");
+            FAIL("no exception");
+        } catch (FlaggedTError const& e) {
+            REQUIRE(e.kind() == FlagKind::Positive);
+            REQUIRE(e.value() == -2.0);
+        }
+        //no file flag records NonNegative, it's always checked
+        REQUIRE_THROWS(load<FlaggedArray<NonNegative<int>>>("flaggedT_test_positive", Verification::Trusted));
+        REQUIRE(remove("flaggedT_test_positive") == 0);
+
+        save(FixedSized<array<int, 3>, 3>(array<int, 3>({ { 4, 5, 6 } })), "flaggedT_test_fixed");
+        for (auto verification : all) {
+            REQUIRE((load<FixedSized<array<int, 3>, 3>>("flaggedT_test_fixed", verification).get()[2] == 6));
+            REQUIRE((load<FixedSized<vector<int>, 3>>("flaggedT_test_fixed", verification).get() == vector<int>({ 4, 5, 6 })));
+        }
+        REQUIRE_THROWS((load<FixedSized<array<int, 2>, 2>>("flaggedT_test_fixed")));
+        try {
+            (void)load<FixedSized<vector<int>, 2>>("flaggedT_test_fixed", Verification::Trusted);
+            FAIL("no exception");
+        } catch (FlaggedTError const& e) {
+            REQUIRE(e.kind() == FlagKind::FixedSized);
+            REQUIRE(e.violation() == Violation::TooBig);
+        }
+        REQUIRE(remove("flaggedT_test_fixed") == 0);
+
+        //an odd number of bytes, the checksum pads the last word
+        save(Sorted<vector<int8_t>>(vector<int8_t>({ 5, -3, 9, 1, 0, 7, 2, 8, 4, -1, 6 })), "flaggedT_test_bytes");
+        REQUIRE(load<Sorted<vector<int8_t>>>("flaggedT_test_bytes", Verification::Checksum).get().front() == -3);
+        REQUIRE(remove("flaggedT_test_bytes") == 0);
+
+        //the elements of empty vectors may be null
+        save(Sorted<vector<int>>(vector<int>()), "flaggedT_test_empty");
+        for (auto verification : all) {
+            REQUIRE(load<Sorted<vector<int>>>("flaggedT_test_empty", verification).get().empty());
+            REQUIRE(load<UniqueAndSorted<vector<int>>>("flaggedT_test_empty", verification).get().empty());
+        }
+        REQUIRE(remove("flaggedT_test_empty") == 0);
+        save(UniqueAndSorted<vector<int>>(vector<int>()), "flaggedT_test_empty");
+        for (auto verification : all) {
+            REQUIRE(load<UniqueAndSorted<vector<int>>>("flaggedT_test_empty", verification).get().empty());
+            REQUIRE(load<Sorted<vector<int>>>("flaggedT_test_empty", verification).get().empty());
+        }
+        REQUIRE(remove("flaggedT_test_empty") == 0);
     }
 
     SECTION("UNIQUE") {
@@ -549,6 +1594,16 @@ TEST_CASE("FlaggedT") {
         auto fixed = UniqueAndSorted<vector<int> >(move(dupedUnsorted));
         REQUIRE(is_sorted(fixed.get().begin(), fixed.get().end()));
         REQUIRE(fixed.get().size() == 6);
+
+        auto byAge = UniqueAndSorted<vector<Person>, less<>, by_age>(vector<Person>({ { "Bob", 42 }, { "Alexander", 7 }, { "Al", 7 } }));
+        REQUIRE(byAge.get().size() == 2);
+        REQUIRE(byAge.get()[1].name == "Bob");
+
+        auto fromSorted = UniqueAndSorted<vector<int>, greater<>>(Sorted<vector<int>, greater<>>(vector<int>({ 1, 3, 3, 2 })));
+        REQUIRE(fromSorted.get() == vector<int>({ 3, 2, 1 }));
+
+        auto fromUnique = UniqueAndSorted<vector<int>>(Unique<vector<int>>(vector<int>({ 3, 1, 3, 2 })));
+        REQUIRE(fromUnique.get() == vector<int>({ 1, 2, 3 }));
     }
 
     SECTION("EqualSized") {
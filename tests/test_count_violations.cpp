@@ -0,0 +1,69 @@
+/*
+    Copyright (c) 2016 Martin Buck
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#define CATCH_CONFIG_MAIN
+#include "../dependencies/Catch.h" //https://github.com/philsquared/Catch
+
+#include <vector>
+
+#define FLAGGEDT_COUNT_VIOLATIONS
+#include "flaggedT.h"
+
+using namespace std;
+using namespace flaggedT;
+
+TEST_CASE("FlaggedT FLAGGEDT_COUNT_VIOLATIONS") {
+    SECTION("clamping") {
+        const auto before = violation_count();
+
+        REQUIRE(Positive<int>(-5).get() == 1);
+        REQUIRE(Positive<int>(0).get() == 1);
+        REQUIRE(Positive<double>(-1.0).get() > 0.0);
+        REQUIRE(NonZero<int>(0).get() == 1);
+        REQUIRE(Negative<int>(0).get() == -1);
+        REQUIRE(NonNegative<int>(-3).get() == 0);
+        REQUIRE(NonPositive<int>(3).get() == 0);
+        REQUIRE((CeiledInclusive<int, 5>(7).get() == 5));
+        REQUIRE((CeiledExclusive<int, 5>(7).get() == 4));
+        REQUIRE((FlooredInclusive<int, 5>(3).get() == 5));
+        REQUIRE((FlooredExclusive<int, 5>(3).get() == 6));
+        REQUIRE((BoundedInclusive<int, 0, 10>(11).get() == 10));
+        REQUIRE((BoundedInclusive<int, 0, 10>(-1).get() == 0));
+        REQUIRE((BoundedExclusive<double, 0, 1>(2.0).get() < 1.0));
+
+        REQUIRE((violation_count() - before) == 14u);
+
+        //valid input isn't counted
+        REQUIRE(Positive<int>(3).get() == 3);
+        REQUIRE((violation_count() - before) == 14u);
+    }
+
+    SECTION("buffers") {
+        const auto before = violation_count();
+
+        auto arr = FlaggedArray<BoundedInclusive<int, 0, 9>>(vector<int>({ -1, 5, 12 }));
+        REQUIRE(arr[0].get() == 0);
+        REQUIRE(arr[1].get() == 5);
+        REQUIRE(arr[2].get() == 9);
+        REQUIRE((violation_count() - before) == 2u);
+    }
+
+    SECTION("no valid value to clamp to") {
+        const auto before = violation_count();
+
+        REQUIRE_THROWS(PowerOfTwo<int>(6));
+        REQUIRE_THROWS(NonEmpty<vector<int>>(vector<int>()));
+        REQUIRE((violation_count() - before) == 2u);
+    }
+}
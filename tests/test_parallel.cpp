@@ -0,0 +1,106 @@
+/*
+    Copyright (c) 2016 Martin Buck
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#define CATCH_CONFIG_MAIN
+#include "../dependencies/Catch.h" //https://github.com/philsquared/Catch
+
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#define FLAGGEDT_PARALLEL
+#define FLAGGEDT_PARALLEL_THREADS 4 //independent of the machine
+#define FLAGGEDT_PARALLEL_MIN_SIZE 1
+#include "flaggedT.h"
+
+using namespace std;
+using namespace flaggedT;
+
+struct by_length {
+    size_t operator()(string const& s) const {
+        return s.size();
+    }
+};
+
+TEST_CASE("FlaggedT FLAGGEDT_PARALLEL") {
+    SECTION("UniqueAndSorted") {
+        mt19937 gen(42);
+        for (size_t n : { 1, 2, 3, 4, 5, 17, 1000, 100000 }) {
+            for (size_t range : { size_t(1), size_t(3), n, 10 * n }) {
+                vector<int> raw(n);
+                for (auto& x : raw)
+                    x = static_cast<int>(gen() % range);
+
+                auto expected = raw;
+                sort(expected.begin(), expected.end());
+                expected.erase(unique(expected.begin(), expected.end()), expected.end());
+                REQUIRE(UniqueAndSorted<vector<int>>(vector<int>(raw)).get() == expected);
+
+                reverse(expected.begin(), expected.end());
+                REQUIRE((UniqueAndSorted<vector<int>, greater<>>(vector<int>(raw)).get() == expected));
+            }
+        }
+
+        vector<string> words({ "a", "bb", "c", "ddd", "ee", "f", "gggg", "hh" });
+        auto byLength = UniqueAndSorted<vector<string>, less<>, by_length>(move(words));
+        REQUIRE(byLength.get().size() == 4);
+        for (size_t i = 0; i < 4; ++i)
+            REQUIRE(byLength.get()[i].size() == i + 1);
+    }
+
+    SECTION("load") {
+        //4 chunks of 25 elements, each pair across their boundaries is checked
+        for (size_t broken : { size_t(0), size_t(1), size_t(24), size_t(25), size_t(26), size_t(75), size_t(99) }) {
+            vector<int> raw(100);
+            for (size_t i = 0; i < raw.size(); ++i)
+                raw[i] = static_cast<int>(2 * i);
+            raw[broken] = broken == 0 ? 1000 : -1;
+            FILE* file = fopen("flaggedT_test_parallel", "wb");
+            REQUIRE(file);
+            const char header[64] = { 'F', 'L', 'A', 'G', 'G', 'E', 'D', 'T', 1, 0, 0, 0, 3, 0, 0, 0, 4, 0, 0, 0, 0, 0, 0, 0, 100 };
+            REQUIRE(fwrite(header, 1, sizeof(header), file) == sizeof(header));
+            REQUIRE(fwrite(raw.data(), sizeof(int), raw.size(), file) == raw.size());
+            REQUIRE(fclose(file) == 0);
+
+            //the header records sorted and unique, but not the checksum
+            REQUIRE(load<Sorted<vector<int>>>("flaggedT_test_parallel", Verification::Trusted).get() == raw);
+            REQUIRE_THROWS(load<Sorted<vector<int>>>("flaggedT_test_parallel", Verification::Checksum));
+            auto expected = raw;
+            sort(expected.begin(), expected.end());
+            REQUIRE(load<Sorted<vector<int>>>("flaggedT_test_parallel").get() == expected);
+            REQUIRE(load<UniqueAndSorted<vector<int>>>("flaggedT_test_parallel").get() == expected);
+            REQUIRE(remove("flaggedT_test_parallel") == 0);
+        }
+
+        vector<int> raw(1001);
+        for (size_t i = 0; i < raw.size(); ++i)
+            raw[i] = static_cast<int>(i % 10);
+        const auto sorted = Sorted<vector<int>>(vector<int>(raw));
+        save(sorted, "flaggedT_test_parallel");
+        REQUIRE(load<Sorted<vector<int>>>("flaggedT_test_parallel", Verification::Checksum).get() == sorted.get());
+        REQUIRE(load<Sorted<vector<int>>>("flaggedT_test_parallel").get() == sorted.get());
+        REQUIRE(load<UniqueAndSorted<vector<int>>>("flaggedT_test_parallel").get().size() == 10);
+        REQUIRE(load<Unique<vector<int>>>("flaggedT_test_parallel").get().size() == 10);
+        REQUIRE(remove("flaggedT_test_parallel") == 0);
+
+        raw[700] = -1;
+        REQUIRE_THROWS(FlaggedArray<NonNegative<int>>(vector<int>(raw)));
+        save(FlaggedArray<NonNegative<int>>(vector<int>(raw.begin(), raw.begin() + 700)), "flaggedT_test_parallel");
+        REQUIRE(load<FlaggedArray<NonNegative<int>>>("flaggedT_test_parallel").size() == 700);
+        REQUIRE(remove("flaggedT_test_parallel") == 0);
+    }
+}